@@ -0,0 +1,167 @@
+// BandwidthLimiter.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Global token bucket with a time-of-day rate schedule.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "BandwidthLimiter.h"
+
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTime>
+#include <algorithm>
+#include <cmath>
+
+// Bucket depth: a quarter second of traffic, so a paused reader can't burst
+// far above the rate when it wakes up.
+static constexpr double BURST_SECONDS = 0.25;
+static constexpr qint64 MIN_BURST     = 16 * 1024;
+// Don't wake readers for a trickle; wait until this much can be granted.
+static constexpr qint64 MIN_GRANT     = 4 * 1024;
+
+static qint64 burstFor(qint64 rate) {
+    return std::max<qint64>(MIN_BURST, static_cast<qint64>(rate * BURST_SECONDS));
+}
+
+static bool inWindow(const BandwidthLimiter::Window& w, int minute) {
+    if (w.startMin == w.endMin) return true;   // Whole day
+    if (w.startMin < w.endMin) return minute >= w.startMin && minute < w.endMin;
+    return minute >= w.startMin || minute < w.endMin;
+}
+
+qint64 BandwidthLimiter::effectiveRate() {
+    if (m_cachedRate < 0 || !m_rateAge.isValid() || m_rateAge.elapsed() >= 1000) {
+        const QTime now = QTime::currentTime();
+        const int minute = now.hour() * 60 + now.minute();
+        m_cachedRate = m_rate;
+        for (const Window& w : m_schedule) {
+            if (inWindow(w, minute)) { m_cachedRate = w.rateBps; break; }
+        }
+        m_rateAge.start();
+    }
+    return m_cachedRate;
+}
+
+void BandwidthLimiter::refill() {
+    const qint64 rate = effectiveRate();
+    if (!m_lastRefill.isValid()) {
+        m_lastRefill.start();
+        m_tokens = static_cast<double>(burstFor(rate));
+        return;
+    }
+    const qint64 elapsedMs = m_lastRefill.restart();
+    m_tokens = std::min(m_tokens + rate * elapsedMs / 1000.0,
+                        static_cast<double>(burstFor(rate)));
+}
+
+qint64 BandwidthLimiter::take(qint64 want) {
+    if (want <= 0) return 0;
+    QMutexLocker lk(&m_lock);
+    if (effectiveRate() == 0) {
+        m_bytesTotal += want;
+        return want;
+    }
+    refill();
+    if (m_tokens < static_cast<double>(std::min(want, MIN_GRANT))) return 0;
+    const qint64 grant = std::min(want, static_cast<qint64>(m_tokens));
+    m_tokens     -= static_cast<double>(grant);
+    m_bytesTotal += grant;
+    return grant;
+}
+
+void BandwidthLimiter::charge(qint64 bytes) {
+    if (bytes <= 0) return;
+    QMutexLocker lk(&m_lock);
+    m_bytesTotal += bytes;
+    if (effectiveRate() == 0) return;
+    refill();
+    m_tokens -= static_cast<double>(bytes);
+}
+
+qint64 BandwidthLimiter::waitMs() {
+    QMutexLocker lk(&m_lock);
+    const qint64 rate = effectiveRate();
+    if (rate == 0) return 0;
+    refill();
+    const double need = static_cast<double>(std::min(MIN_GRANT, burstFor(rate))) - m_tokens;
+    if (need <= 0) return 0;
+    // Capped so a schedule change (or a new rate) is picked up promptly.
+    return std::clamp<qint64>(static_cast<qint64>(std::ceil(need * 1000.0 / rate)), 1, 1000);
+}
+
+bool BandwidthLimiter::active() {
+    QMutexLocker lk(&m_lock);
+    return effectiveRate() > 0;
+}
+
+void BandwidthLimiter::setRate(qint64 bytesPerSec) {
+    QMutexLocker lk(&m_lock);
+    m_rate       = std::max<qint64>(0, bytesPerSec);
+    m_cachedRate = -1;
+}
+
+bool BandwidthLimiter::setSchedule(const QString& spec) {
+    std::vector<Window> windows;
+    if (!parseSchedule(spec, windows)) return false;
+    QMutexLocker lk(&m_lock);
+    m_schedule   = std::move(windows);
+    m_cachedRate = -1;
+    return true;
+}
+
+BandwidthStatus BandwidthLimiter::status() {
+    QMutexLocker lk(&m_lock);
+    BandwidthStatus s;
+    s.rateBps      = m_rate;
+    s.effectiveBps = effectiveRate();
+    s.schedule     = formatSchedule(m_schedule).toStdString();
+    s.bytesTotal   = m_bytesTotal;
+    return s;
+}
+
+qint64 BandwidthLimiter::bytesTotal() {
+    QMutexLocker lk(&m_lock);
+    return m_bytesTotal;
+}
+
+// ── Schedule string ──────────────────────────────────────────────────────────
+// "22:00-07:00=0,09:00-18:00=512K" – first matching window wins.
+
+bool BandwidthLimiter::parseSchedule(const QString& spec, std::vector<Window>& out) {
+    static const QRegularExpression re(
+        R"(^(\d{1,2}):(\d{2})-(\d{1,2}):(\d{2})=(\d+)([KkMm]?)$)");
+    out.clear();
+    for (const QString& part : spec.split(',', Qt::SkipEmptyParts)) {
+        const QRegularExpressionMatch m = re.match(part.trimmed());
+        if (!m.hasMatch()) return false;
+        const int h1 = m.captured(1).toInt(), m1 = m.captured(2).toInt();
+        const int h2 = m.captured(3).toInt(), m2 = m.captured(4).toInt();
+        if (h1 > 23 || m1 > 59 || h2 > 24 || m2 > 59 || (h2 == 24 && m2 != 0)) return false;
+
+        Window w;
+        w.startMin = h1 * 60 + m1;
+        w.endMin   = (h2 * 60 + m2) % (24 * 60);
+        w.rateBps  = m.captured(5).toLongLong();
+        const QString unit = m.captured(6).toUpper();
+        if (unit == "K") w.rateBps *= 1024;
+        if (unit == "M") w.rateBps *= 1024 * 1024;
+        out.push_back(w);
+    }
+    return true;
+}
+
+QString BandwidthLimiter::formatSchedule(const std::vector<Window>& windows) {
+    auto hm = [](int minutes) {
+        return QString("%1:%2").arg(minutes / 60, 2, 10, QChar('0'))
+                               .arg(minutes % 60, 2, 10, QChar('0'));
+    };
+    auto rate = [](qint64 bps) {
+        if (bps > 0 && bps % (1024 * 1024) == 0) return QString("%1M").arg(bps / (1024 * 1024));
+        if (bps > 0 && bps % 1024 == 0)          return QString("%1K").arg(bps / 1024);
+        return QString::number(bps);
+    };
+    QStringList parts;
+    for (const Window& w : windows)
+        parts << QString("%1-%2=%3").arg(hm(w.startMin), hm(w.endMin), rate(w.rateBps));
+    return parts.join(',');
+}
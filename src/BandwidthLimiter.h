@@ -0,0 +1,80 @@
+#ifndef BANDWIDTHLIMITER_H
+#define BANDWIDTHLIMITER_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <string>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// BandwidthStatus – GET /api/download/bandwidth
+// ════════════════════════════════════════════════════════════════════════════
+
+struct BandwidthStatus {
+    qint64      rateBps      = 0;   // Configured base rate (0 = unlimited)
+    qint64      effectiveBps = 0;   // Rate in force right now (schedule applied)
+    std::string schedule;           // Canonical schedule string, see parseSchedule
+    qint64      bytesTotal   = 0;   // Bytes that passed the limiter this session
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// BandwidthLimiter – process-wide token bucket for download bodies
+//
+// Every body read (DownloadSink, segment fetches) asks take() how many bytes
+// it may consume. Bytes it leaves in the reply's 256 KiB read buffer stop
+// Qt reading the socket, so TCP flow control slows the sender instead of
+// the launcher buffering ahead. Tails drained after finished() are charge()d
+// as debt, which keeps the long-run average at the configured rate.
+//
+// The rate can be overridden by time of day, e.g. "09:00-18:00=1M" keeps
+// office hours at 1 MiB/s and leaves the rest of the day at the base rate.
+// Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class BandwidthLimiter {
+public:
+    struct Window {
+        int    startMin = 0;   // Minutes after midnight, inclusive
+        int    endMin   = 0;   // Exclusive; may be < startMin (wraps midnight)
+        qint64 rateBps  = 0;   // 0 = unlimited inside this window
+    };
+
+    // Granted bytes, 0..want. Never blocks.
+    qint64 take(qint64 want);
+    // Records bytes that were consumed without asking (may go into debt).
+    void   charge(qint64 bytes);
+    // Milliseconds until take() can grant something again (0 = now).
+    qint64 waitMs();
+    // True while a finite rate is in force; size-scaled deadlines are
+    // meaningless then, because the limiter sets the pace.
+    bool   active();
+
+    void setRate(qint64 bytesPerSec);
+    // "HH:MM-HH:MM=<rate>[,…]"; rate is bytes/s with an optional K/M suffix
+    // (KiB/MiB), 0 = unlimited. Empty clears the schedule. False if malformed.
+    bool setSchedule(const QString& spec);
+
+    BandwidthStatus status();
+    // Body bytes metered so far (every download passes through here, capped
+    // or not); ProgressMeter samples it for live byte progress.
+    qint64 bytesTotal();
+
+    static bool    parseSchedule(const QString& spec, std::vector<Window>& out);
+    static QString formatSchedule(const std::vector<Window>& windows);
+
+private:
+    qint64 effectiveRate();   // m_lock held
+    void   refill();          // m_lock held
+
+    QMutex              m_lock;
+    qint64              m_rate = 0;
+    std::vector<Window> m_schedule;
+    double              m_tokens = 0;
+    QElapsedTimer       m_lastRefill;
+    qint64              m_cachedRate = -1;   // Schedule lookup, refreshed each second
+    QElapsedTimer       m_rateAge;
+    qint64              m_bytesTotal = 0;
+};
+
+#endif // BANDWIDTHLIMITER_H
@@ -0,0 +1,89 @@
+// DiskSync.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Temp-file preallocation, atomic rename and per-batch sync.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "DiskSync.h"
+
+#include <QMutexLocker>
+#include <QString>
+#include <filesystem>
+#include <set>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+void DiskSync::reserve(QFile& f, qint64 bytes) {
+    if (!f.isOpen() || bytes <= 0 || f.handle() < 0) return;
+#if defined(Q_OS_WIN)
+    // Allocation size, not end-of-file: the file still reads as its
+    // current length.
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = bytes;
+    HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(f.handle()));
+    if (h != INVALID_HANDLE_VALUE)
+        SetFileInformationByHandle(h, FileAllocationInfo, &info, sizeof(info));
+#elif defined(Q_OS_LINUX)
+    // Not posix_fallocate: that extends the visible size.
+    ::fallocate(f.handle(), FALLOC_FL_KEEP_SIZE, 0, bytes);
+#else
+    Q_UNUSED(bytes);
+#endif
+}
+
+bool DiskSync::commit(const std::string& tmp, const std::string& dst, std::error_code& ec) {
+    fs::rename(tmp, dst, ec);
+    if (ec) return false;
+    QMutexLocker lk(&m_lock);
+    m_pending.push_back(dst);
+    return true;
+}
+
+int DiskSync::flush() {
+    std::vector<std::string> files;
+    {
+        QMutexLocker lk(&m_lock);
+        files.swap(m_pending);
+    }
+    if (files.empty()) return 0;
+
+#if defined(Q_OS_WIN)
+    // NTFS journals the renames themselves; only file data needs flushing,
+    // and FlushFileBuffers requires a handle opened for writing.
+    for (const std::string& p : files) {
+        HANDLE h = CreateFileW(QString::fromStdString(p).toStdWString().c_str(),
+                               GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE) continue;
+        FlushFileBuffers(h);
+        CloseHandle(h);
+    }
+#else
+    std::set<std::string> dirs;
+    for (const std::string& p : files) dirs.insert(fs::path(p).parent_path().string());
+    // Each file's data, then each distinct parent directory once so the
+    // renames themselves are durable. Scoped to what this batch wrote –
+    // unlike syncfs(), which would also flush unrelated dirty pages.
+    for (const std::string& p : files) {
+        const int fd = ::open(p.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        ::fsync(fd);
+        ::close(fd);
+    }
+    for (const std::string& d : dirs) {
+        const int fd = ::open(d.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        ::fsync(fd);
+        ::close(fd);
+    }
+#endif
+    return static_cast<int>(files.size());
+}
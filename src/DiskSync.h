@@ -0,0 +1,41 @@
+#ifndef DISKSYNC_H
+#define DISKSYNC_H
+
+#include <QFile>
+#include <QMutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// DiskSync – preallocation and batched durability for downloaded files
+//
+// Bodies land in a sibling temp file (.part / .seg) and are renamed over the
+// final path only once verified. reserve() allocates the expected size up
+// front so a file is laid out in one extent instead of growing 256 KiB at a
+// time next to thousands of others. commit() does the rename and remembers
+// the file; flush(), called once at the end of a batch, makes all of them
+// and their directories durable together instead of syncing per file. A
+// crash before flush() may leave a renamed file short, which validateFile()
+// catches on the next run. Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class DiskSync {
+public:
+    // Reserves disk space for `bytes` without changing the file's size, so
+    // resume offsets and short-body checks are unaffected. Best effort.
+    static void reserve(QFile& f, qint64 bytes);
+
+    // Renames `tmp` over `dst` (atomic within a directory) and queues `dst`
+    // for the next flush().
+    bool commit(const std::string& tmp, const std::string& dst, std::error_code& ec);
+    // Syncs every file committed since the last flush, then each of their
+    // directories once. Returns the number of files covered.
+    int flush();
+
+private:
+    QMutex                   m_lock;
+    std::vector<std::string> m_pending;
+};
+
+#endif // DISKSYNC_H
@@ -0,0 +1,782 @@
+// DownloadEngine.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  DownloadSink   – streaming body → .part file with incremental SHA1
+//  DownloadEngine – single-threaded async scheduler used by batchDownload
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "DownloadEngine.h"
+#include "DiskSync.h"
+
+#include <QHttp1Configuration>
+#include <QNetworkAccessManager>
+#include <QSet>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Same read granularity / back-pressure bound as the blocking path.
+static constexpr qint64 SINK_CHUNK_BYTES = 256 * 1024;
+
+// ── Hedging ──────────────────────────────────────────────────────────────────
+// A transfer is hedged once it is at least HEDGE_MIN_AGE_MS old and either
+// has no response after 4× the batch's p90 TTFB, or moves its body at under
+// HEDGE_SLOW_FRACTION of the batch's median throughput with more than
+// HEDGE_MIN_REMAINING_MS of work left at that pace.
+static constexpr qint64 HEDGE_MIN_AGE_MS       = 2000;
+static constexpr double HEDGE_SLOW_FRACTION    = 0.3;
+static constexpr qint64 HEDGE_MIN_REMAINING_MS = 2000;
+static constexpr size_t HEDGE_MIN_SAMPLES      = 8;     // Completed transfers before judging
+static constexpr size_t HEDGE_HISTORY          = 256;
+static constexpr qint64 HEDGE_SIZED_BYTES      = 64 * 1024;
+
+static double percentile(std::deque<double> v, double q) {
+    const size_t k = static_cast<size_t>(q * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DownloadSink
+// ════════════════════════════════════════════════════════════════════════════
+
+DownloadSink::DownloadSink(const std::string& tmpPath, int expectedSize,
+                           LauncherCore::PartialDownload* resume,
+                           BandwidthLimiter* limiter)
+    : m_tmpPath(tmpPath), m_expectedSize(expectedSize), m_resume(resume),
+      m_limiter(limiter), m_out(QString::fromStdString(tmpPath)) {}
+
+bool DownloadSink::open(const QString& url, QNetworkRequest& req) {
+    m_url = url;
+
+    // ── Decide whether the existing .part can be continued from here ─────
+    // Validators are per-server, so If-Range is only meaningful against the
+    // mirror that produced them. A known SHA1 makes that unnecessary.
+    m_offset = m_resume ? m_resume->offset : 0;
+    const bool sameSource   = m_resume && m_resume->source == url;
+    const bool hasValidator = m_resume && (!m_resume->etag.isEmpty() ||
+                                           !m_resume->lastModified.isEmpty());
+    if (m_offset > 0 && m_resume->sha1.empty() && !(sameSource && hasValidator))
+        m_offset = 0;
+
+    if (m_offset > 0) {
+        if (!m_out.open(QIODevice::ReadWrite)) m_offset = 0;
+        // Re-hash what is already on disk so the final SHA1 covers the whole
+        // file; this is one sequential read instead of re-downloading it.
+        while (m_offset > 0 && m_out.pos() < m_offset) {
+            QByteArray b = m_out.read(std::min(SINK_CHUNK_BYTES, m_offset - m_out.pos()));
+            if (b.isEmpty()) break;
+            m_hash.addData(b.constData(), static_cast<size_t>(b.size()));
+        }
+        if (m_offset > 0 && m_out.pos() != m_offset) {
+            m_out.close();
+            m_hash.reset();
+            m_offset = 0;
+        }
+    }
+    if (m_offset == 0 && !m_out.isOpen() &&
+        !m_out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    if (m_offset == 0) { m_out.resize(0); m_out.seek(0); }
+    DiskSync::reserve(m_out, m_expectedSize);
+    m_received = m_offset;
+
+    if (m_offset > 0) {
+        req.setRawHeader("Range", "bytes=" + QByteArray::number(m_offset) + "-");
+        // Weak ETags are not allowed in If-Range; fall back to Last-Modified.
+        if (sameSource && !m_resume->etag.isEmpty() && !m_resume->etag.startsWith("W/"))
+            req.setRawHeader("If-Range", m_resume->etag);
+        else if (sameSource && !m_resume->lastModified.isEmpty())
+            req.setRawHeader("If-Range", m_resume->lastModified);
+    }
+    m_clock.start();
+    return true;
+}
+
+// First 2xx headers: reconcile the Range answer and record validators.
+void DownloadSink::onHeaders(QNetworkReply* reply, int code) {
+    m_headersSeen = true;
+    m_ttfbMs      = m_clock.elapsed();
+    if (m_offset > 0 && code == 200) {
+        // Range ignored or If-Range failed – the body is the full file.
+        m_out.resize(0);
+        m_out.seek(0);
+        DiskSync::reserve(m_out, m_expectedSize);
+        m_hash.reset();
+        m_received = 0;
+        m_offset   = 0;
+    } else if (m_offset > 0 && code == 206) {
+        const QByteArray cr = reply->rawHeader("Content-Range");
+        if (!cr.startsWith("bytes " + QByteArray::number(m_offset) + "-")) {
+            m_rangeMismatch = true;
+            reply->abort();
+            return;
+        }
+    }
+    if (m_resume) {
+        m_resume->etag         = reply->rawHeader("ETag");
+        m_resume->lastModified = reply->rawHeader("Last-Modified");
+        m_resume->source       = m_url;
+        LauncherCore::savePartial(m_tmpPath, *m_resume);
+    }
+}
+
+// Pull whatever is buffered, hash it and write it out in one pass.
+// Error bodies (4xx/5xx pages) are discarded so they never reach disk.
+void DownloadSink::drain(QNetworkReply* reply) {
+    consume(reply, true);
+}
+
+bool DownloadSink::backlogged(QNetworkReply* reply) const {
+    return m_limiter && reply->bytesAvailable() > 0 &&
+           !m_overflow && !m_writeError && !m_rangeMismatch;
+}
+
+// `throttled` = ask the limiter first. The tail read in finish() is taken
+// unconditionally (it is already buffered) and charged as debt instead.
+void DownloadSink::consume(QNetworkReply* reply, bool throttled) {
+    const int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (code != 0 && (code < 200 || code >= 300)) { reply->readAll(); return; }
+    if (!m_headersSeen) onHeaders(reply, code);
+    while (reply->bytesAvailable() > 0 && !m_overflow && !m_writeError && !m_rangeMismatch) {
+        qint64 n = std::min(SINK_CHUNK_BYTES, reply->bytesAvailable());
+        if (m_limiter && throttled) {
+            n = m_limiter->take(n);
+            if (n == 0) return;
+        } else if (m_limiter) {
+            m_limiter->charge(n);
+        }
+        QByteArray chunk = reply->read(n);
+        m_received  += chunk.size();
+        m_bodyBytes += chunk.size();
+        if (m_expectedSize > 0 && m_received > m_expectedSize) {
+            m_overflow = true;
+            reply->abort();
+            return;
+        }
+        m_hash.addData(chunk.constData(), static_cast<size_t>(chunk.size()));
+        if (m_out.write(chunk) != chunk.size()) {
+            m_writeError = true;
+            reply->abort();
+            return;
+        }
+    }
+}
+
+DownloadSink::Result DownloadSink::finish(QNetworkReply* reply) {
+    // Tail that arrived together with finished()
+    if (reply->error() == QNetworkReply::NoError) consume(reply, false);
+
+    m_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    Result r = Result::Ok;
+    if      (m_overflow)      r = Result::Overflow;
+    else if (m_writeError)    r = Result::WriteError;
+    else if (m_rangeMismatch) r = Result::RangeMismatch;
+    else if (reply->error() == QNetworkReply::OperationCanceledError) r = Result::Cancelled;
+    else if (reply->error() != QNetworkReply::NoError) {
+        r = Result::NetError;
+        m_netError = reply->errorString();
+    }
+    else if (m_code < 200 || m_code >= 300) r = Result::HttpError;
+    else if (m_expectedSize > 0 && m_received != m_expectedSize) r = Result::Short;
+
+    if (m_writeError) m_netError = m_out.errorString();
+    m_netErrorCode = reply->error();
+    m_result       = r;
+    m_out.close();
+    if (m_resume) {
+        m_resume->offset = m_out.size();
+        // Corrupt/oversized bodies and 416 (part longer than the file)
+        // cannot be continued; anything else is kept for the next attempt.
+        m_resume->discard = m_overflow || m_rangeMismatch || m_code == 416;
+    }
+    return r;
+}
+
+MirrorHealth::Sample DownloadSink::sample(bool ok) const {
+    MirrorHealth::Sample s;
+    s.ok        = ok;
+    s.ttfbMs    = m_ttfbMs;
+    s.bytes     = m_bodyBytes;
+    s.elapsedMs = m_clock.elapsed();
+    s.httpCode  = m_code;
+    s.stalled   = m_result == Result::Cancelled;
+    s.reset     = m_netErrorCode == QNetworkReply::RemoteHostClosedError ||
+                  m_netErrorCode == QNetworkReply::ConnectionRefusedError ||
+                  m_netErrorCode == QNetworkReply::TimeoutError ||
+                  m_netErrorCode == QNetworkReply::TemporaryNetworkFailureError;
+    return s;
+}
+
+QString DownloadSink::errorText(Result r, const QString& url) const {
+    switch (r) {
+        case Result::Overflow:
+            return QString("[Size] Body exceeds %1 bytes, aborted: %2").arg(m_expectedSize).arg(url);
+        case Result::Short:
+            return QString("[Size] Got %1 of %2 bytes: %3")
+                   .arg(m_received).arg(m_expectedSize).arg(url);
+        case Result::WriteError:
+            return QString("[IO] Write failed (%1): %2")
+                   .arg(m_netError).arg(QString::fromStdString(m_tmpPath));
+        case Result::RangeMismatch:
+            return QString("[Range] Unexpected Content-Range from %1").arg(url);
+        case Result::HttpError:
+            return QString("[HTTP %1] %2").arg(m_code).arg(url);
+        case Result::NetError:
+            return QString("[Net] %1 | %2").arg(m_netError).arg(url);
+        case Result::Ok:
+        case Result::Cancelled:
+            break;
+    }
+    return {};
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// DownloadEngine
+// ════════════════════════════════════════════════════════════════════════════
+
+DownloadEngine::DownloadEngine(LauncherCore* core) : m_core(core) {
+    m_clock.start();
+}
+
+DownloadEngine::~DownloadEngine() {
+    // Runs on the engine thread (see ~LauncherCore); drop what is left.
+    for (auto& [reply, t] : m_running) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+        if (t->hedge) {
+            t->hedge->reply->disconnect(this);
+            t->hedge->reply->abort();
+            t->hedge->reply->deleteLater();
+        }
+    }
+}
+
+void DownloadEngine::setMaxInFlight(int n) {
+    m_maxInFlight = std::max(1, n);
+    QMetaObject::invokeMethod(this, [this]() { pump(); }, Qt::QueuedConnection);
+}
+
+void DownloadEngine::setConnectionsPerHost(int n) {
+    m_connectionsPerHost = std::max(1, n);
+}
+
+void DownloadEngine::submit(const LauncherCore::DownloadTask& task, Callback done) {
+    auto t     = std::make_unique<Transfer>();
+    t->task    = task;
+    t->urls    = m_core->candidateUrls(task.url, task.path);
+    t->tmpPath  = task.path + ".part";
+    t->sinkPath = t->tmpPath;
+    t->done     = std::move(done);
+
+    // std::function needs a copyable callable; hand the transfer over raw and
+    // re-wrap it on the engine thread.
+    Transfer* raw = t.release();
+    QMetaObject::invokeMethod(this, [this, raw]() {
+        enqueue(std::unique_ptr<Transfer>(raw));
+    }, Qt::QueuedConnection);
+}
+
+void DownloadEngine::ensureStarted() {
+    if (m_nam) return;
+    // First use: the manager and sweep timer must belong to this thread.
+    m_nam   = new QNetworkAccessManager(this);
+    m_sweep = new QTimer(this);
+    connect(m_sweep, &QTimer::timeout, this, &DownloadEngine::sweepStalled);
+    m_sweep->start(1000);
+    m_throttle = new QTimer(this);
+    m_throttle->setSingleShot(true);
+    connect(m_throttle, &QTimer::timeout, this, &DownloadEngine::resumeThrottled);
+    m_backoff = new QTimer(this);
+    m_backoff->setSingleShot(true);
+    connect(m_backoff, &QTimer::timeout, this, &DownloadEngine::pump);
+}
+
+void DownloadEngine::prewarm(const QStringList& urls,
+                             std::function<void(const QString&, qint64)> connected) {
+    QMetaObject::invokeMethod(this, [this, urls, connected]() {
+        ensureStarted();
+        for (const QString& url : urls) {
+            // Same attributes as a transfer, so Qt files the socket under the
+            // connection pool key the downloads will look up.
+            QNetworkRequest req = m_core->buildRequest(url.toStdString());
+            QHttp1Configuration h1;
+            h1.setNumberOfConnectionsPerHost(m_connectionsPerHost.load());
+            req.setHttp1Configuration(h1);
+            req.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                             QNetworkRequest::ManualRedirectPolicy);
+            req.setTransferTimeout(m_core->m_retry.stallTimeoutMs);
+
+            QNetworkReply* reply = m_nam->head(req);
+            m_core->trackConnection(reply);
+            const qint64 started = m_clock.elapsed();
+            connect(reply, &QNetworkReply::finished, this, [this, reply, started, connected]() {
+                // Any HTTP status means the connection is up.
+                const bool up = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid();
+                if (connected) connected(reply->url().host().toLower(),
+                                         up ? m_clock.elapsed() - started : -1);
+                reply->deleteLater();
+            });
+        }
+    }, Qt::QueuedConnection);
+}
+
+void DownloadEngine::enqueue(std::unique_ptr<Transfer> t) {
+    ensureStarted();
+
+    // Part state is loaded once per file; mirrors then share it.
+    std::error_code ec;
+    fs::create_directories(fs::path(t->task.path).parent_path(), ec);
+    t->part = LauncherCore::loadPartial(t->tmpPath, t->task.size, t->task.sha1);
+    // Pool workers submit in whatever order verification finishes; keep the
+    // queue in batchDownload's order (priority class, then largest first).
+    auto pos = std::upper_bound(m_pending.begin(), m_pending.end(), t,
+        [](const std::unique_ptr<Transfer>& a, const std::unique_ptr<Transfer>& b) {
+            return LauncherCore::scheduledBefore(a->task, b->task);
+        });
+    m_pending.insert(pos, std::move(t));
+    pump();
+}
+
+// Starts queued transfers in FIFO order while the global cap allows, but
+// only on hosts whose AIMD window (HostConcurrency) still has a free slot.
+// A transfer for a full host is skipped, not blocking the ones behind it.
+// The memory budget is global, so once it is exhausted nothing behind the
+// head may start either – otherwise small files would starve a large one.
+void DownloadEngine::pump() {
+    releaseDue();
+    QSet<QString> full;
+    std::vector<std::unique_ptr<Transfer>> tripped;   // Mirror's breaker is open
+    for (auto it = m_pending.begin();
+         it != m_pending.end() &&
+         static_cast<int>(m_running.size()) < m_maxInFlight.load();) {
+        const QString url  = (*it)->urls.value((*it)->mirror);
+        const QString host = HostConcurrency::hostOf(url);
+        MemoryBudget::Lease mem;
+        if (!url.isEmpty()) {
+            if (full.contains(host)) { ++it; continue; }
+            mem = m_core->m_memory.tryAcquire(m_core->transferCost((*it)->task));
+            if (!mem.held()) break;
+            if (!m_core->m_hostLimits.tryAcquire(host)) {
+                full.insert(host);
+                ++it;
+                continue;
+            }
+            if (!m_core->m_breakers.allow(host)) {
+                m_core->m_hostLimits.release(host, MirrorHealth::Sample{});
+                tripped.push_back(std::move(*it));
+                it = m_pending.erase(it);
+                continue;
+            }
+        }
+        std::unique_ptr<Transfer> t = std::move(*it);
+        it = m_pending.erase(it);
+        t->mem = std::move(mem);
+        start(std::move(t));
+    }
+    m_active = static_cast<int>(m_running.size());
+
+    // Skipped without a request: move each on to its next mirror (or round).
+    // Every pass advances them, so this recursion ends.
+    if (!tripped.empty()) {
+        for (auto& t : tripped) retryOrFail(std::move(t));
+        pump();
+    }
+}
+
+// Moves transfers whose backoff has elapsed back to the head of the queue
+// and re-arms m_backoff for the earliest one still waiting.
+void DownloadEngine::releaseDue() {
+    if (m_delayed.empty()) return;
+    const qint64 now = m_clock.elapsed();
+    qint64 next = -1;
+    for (auto it = m_delayed.begin(); it != m_delayed.end();) {
+        if (it->first <= now) {
+            m_pending.push_front(std::move(it->second));
+            it = m_delayed.erase(it);
+        } else {
+            next = next < 0 ? it->first : std::min(next, it->first);
+            ++it;
+        }
+    }
+    if (next >= 0) m_backoff->start(static_cast<int>(next - now));
+}
+
+void DownloadEngine::start(std::unique_ptr<Transfer> t) {
+    const QString url = t->urls.value(t->mirror);
+    if (url.isEmpty()) { complete(std::move(t), false); return; }
+
+    QNetworkRequest req = m_core->buildRequest(url.toStdString());
+    QHttp1Configuration h1;
+    h1.setNumberOfConnectionsPerHost(m_connectionsPerHost.load());
+    req.setHttp1Configuration(h1);
+
+    // A hedge that was promoted and then failed leaves its own file behind.
+    if (t->sinkPath != t->tmpPath) {
+        std::error_code ec;
+        fs::remove(t->sinkPath, ec);
+        t->sinkPath = t->tmpPath;
+    }
+    t->sink = std::make_unique<DownloadSink>(t->tmpPath, t->task.size, &t->part,
+                                             &m_core->m_bandwidth);
+    if (!t->sink->open(url, req)) {
+        emit m_core->launchLog(QString("[IO] Cannot open %1 for writing")
+                               .arg(QString::fromStdString(t->tmpPath)));
+        // A local failure says nothing about the host; just hand the slot
+        // (and a half-open breaker probe) back.
+        m_core->m_hostLimits.release(HostConcurrency::hostOf(url), MirrorHealth::Sample{});
+        m_core->m_breakers.abandon(HostConcurrency::hostOf(url));
+        complete(std::move(t), false);
+        return;
+    }
+
+    QNetworkReply* reply = m_nam->get(req);
+    m_core->trackConnection(reply);
+    reply->setReadBufferSize(SINK_CHUNK_BYTES);
+    t->startedAt    = m_clock.elapsed();
+    t->lastActivity = t->startedAt;
+    const qint64 budget = m_core->m_retry.deadlineMs(t->task.size);
+    t->deadline = budget > 0 ? t->startedAt + budget : 0;
+
+    watch(reply);
+    m_running.emplace(reply, std::move(t));
+}
+
+void DownloadEngine::watch(QNetworkReply* reply) {
+    // Handlers look the reply up on every call: a hedge reply can be
+    // promoted to primary while it is running.
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() { onReadyRead(reply); });
+    // Queued: abort() emits finished() synchronously, and onFinished() frees
+    // the sink – which may be the very object that called abort().
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onFinished(reply); },
+            Qt::QueuedConnection);
+}
+
+void DownloadEngine::onReadyRead(QNetworkReply* reply) {
+    DownloadSink* sink = nullptr;
+    if (auto it = m_running.find(reply); it != m_running.end()) {
+        it->second->lastActivity = m_clock.elapsed();
+        sink = it->second->sink.get();
+    } else if (auto h = m_hedges.find(reply); h != m_hedges.end()) {
+        Hedge* hedge = m_running.at(h->second)->hedge.get();
+        hedge->lastActivity = m_clock.elapsed();
+        sink = hedge->sink.get();
+    }
+    if (!sink) return;
+    sink->drain(reply);
+    if (sink->backlogged(reply) && !m_throttle->isActive())
+        m_throttle->start(static_cast<int>(m_core->m_bandwidth.waitMs()));
+}
+
+void DownloadEngine::onFinished(QNetworkReply* reply) {
+    if (m_hedges.count(reply)) {
+        onHedgeFinished(reply);
+        pump();
+        return;
+    }
+    auto it = m_running.find(reply);
+    if (it == m_running.end()) return;
+    std::unique_ptr<Transfer> t = std::move(it->second);
+    m_running.erase(it);
+
+    const QString url = t->urls.value(t->mirror);
+    const DownloadSink::Result r = t->sink->finish(reply);
+    reply->deleteLater();
+    t->mem.reset();
+
+    const bool valid = r == DownloadSink::Result::Ok &&
+                       (t->task.sha1.empty() || t->sink->sha1() == t->task.sha1);
+    const MirrorHealth::Sample sample = t->sink->sample(valid);
+    m_core->m_mirrorHealth.record(QString::fromStdString(t->task.url), url, sample);
+    m_core->m_hostLimits.release(HostConcurrency::hostOf(url), sample);
+    m_core->recordHostOutcome(HostConcurrency::hostOf(url), sample);
+    if (valid) noteCompletion(sample);
+
+    if (r == DownloadSink::Result::Ok) {
+        if (valid) {
+            if (t->hedge) dropHedge(t.get());
+            std::error_code ec;
+            if (m_core->commitVerified(t->sinkPath, t->task.path, t->task.sha1, ec)) {
+                LauncherCore::removePartial(t->tmpPath);
+                complete(std::move(t), true);
+            } else {
+                emit m_core->launchLog(QString("[IO] Rename failed (%1): %2")
+                                       .arg(QString::fromStdString(ec.message()))
+                                       .arg(QString::fromStdString(t->task.path)));
+                LauncherCore::removePartial(t->tmpPath);
+                if (t->sinkPath != t->tmpPath) fs::remove(t->sinkPath, ec);
+                complete(std::move(t), false);
+            }
+        } else {
+            emit m_core->launchLog(
+                QString("[Corrupt] Mirror %1 returned invalid data, trying next mirror: %2")
+                .arg(url).arg(QString::fromStdString(t->task.path)));
+            LauncherCore::removePartial(t->tmpPath);
+            t->part = LauncherCore::loadPartial(t->tmpPath, t->task.size, t->task.sha1);
+        }
+    } else {
+        const QString msg = t->sink->errorText(r, url);
+        if (!msg.isEmpty()) emit m_core->launchLog(msg);
+        // Keep what this mirror delivered for the next one, unless unusable.
+        if (t->part.discard || t->part.offset == 0) {
+            LauncherCore::removePartial(t->tmpPath);
+            t->part = LauncherCore::loadPartial(t->tmpPath, t->task.size, t->task.sha1);
+        }
+    }
+
+    if (!valid && t->hedge) {
+        // The hedge is still racing: it becomes this transfer's only attempt
+        // instead of starting yet another request.
+        std::unique_ptr<Hedge> h = std::move(t->hedge);
+        m_hedges.erase(h->reply);
+        t->sink         = std::move(h->sink);
+        t->sinkPath     = h->path;
+        t->mirror       = h->mirror;
+        t->startedAt    = h->startedAt;
+        t->lastActivity = h->lastActivity;
+        t->deadline     = 0;
+        t->mem          = std::move(h->mem);
+        m_running.emplace(h->reply, std::move(t));
+    } else if (!valid) {
+        retryOrFail(std::move(t));
+    }
+    pump();
+}
+
+// ── Hedging ──────────────────────────────────────────────────────────────────
+
+void DownloadEngine::noteCompletion(const MirrorHealth::Sample& s) {
+    if (s.ttfbMs >= 0) {
+        m_ttfbSamples.push_back(static_cast<double>(s.ttfbMs));
+        if (m_ttfbSamples.size() > HEDGE_HISTORY) m_ttfbSamples.pop_front();
+    }
+    const qint64 bodyMs = s.elapsedMs - std::max<qint64>(0, s.ttfbMs);
+    if (s.bytes >= HEDGE_SIZED_BYTES && bodyMs > 0) {
+        m_rateSamples.push_back(s.bytes * 1000.0 / bodyMs);
+        if (m_rateSamples.size() > HEDGE_HISTORY) m_rateSamples.pop_front();
+    }
+}
+
+// Called from the 1 s sweep. At most ~10% of the in-flight budget is spent
+// on hedges so a generally slow network doesn't double its own load.
+void DownloadEngine::maybeHedge(qint64 now) {
+    if (!m_hedging.load()) return;
+    const bool haveTtfb = m_ttfbSamples.size() >= HEDGE_MIN_SAMPLES;
+    const bool haveRate = m_rateSamples.size() >= HEDGE_MIN_SAMPLES;
+    if (!haveTtfb && !haveRate) return;
+    const double p90Ttfb = haveTtfb ? percentile(m_ttfbSamples, 0.9) : 0;
+    const double p50Rate = haveRate ? percentile(m_rateSamples, 0.5) : 0;
+
+    int budget = std::max(2, m_maxInFlight.load() / 10) - static_cast<int>(m_hedges.size());
+    std::vector<std::pair<Transfer*, QNetworkReply*>> slow;
+    for (const auto& [reply, t] : m_running) {
+        if (t->hedged || t->mirror + 1 >= t->urls.size()) continue;
+        const qint64 age = now - t->startedAt;
+        if (age < HEDGE_MIN_AGE_MS) continue;
+        const DownloadSink& s = *t->sink;
+        bool behind = false;
+        if (!s.headersSeen()) {
+            behind = haveTtfb && age > std::max<double>(HEDGE_MIN_AGE_MS, 4 * p90Ttfb);
+        } else if (haveRate && t->task.size > 0 && !s.backlogged(reply)) {
+            const qint64 bodyMs = age - std::max<qint64>(0, s.ttfbMs());
+            const double rate   = s.bodyBytes() * 1000.0 / std::max<qint64>(1, bodyMs);
+            const double left   = static_cast<double>(t->task.size - s.received());
+            behind = bodyMs >= HEDGE_MIN_AGE_MS && rate < HEDGE_SLOW_FRACTION * p50Rate &&
+                     (rate <= 0 || left * 1000.0 / rate > HEDGE_MIN_REMAINING_MS);
+        }
+        if (behind) slow.emplace_back(t.get(), reply);
+    }
+    for (const auto& [t, reply] : slow) {
+        if (budget <= 0) break;
+        if (startHedge(t, reply)) --budget;
+    }
+}
+
+bool DownloadEngine::startHedge(Transfer* t, QNetworkReply* primary) {
+    const int     mirror = t->mirror + 1;
+    const QString url    = t->urls.value(mirror);
+    const QString host   = HostConcurrency::hostOf(url);
+    // A hedge is a second full transfer and is charged like one.
+    MemoryBudget::Lease mem = m_core->m_memory.tryAcquire(m_core->transferCost(t->task));
+    if (!mem.held()) return false;
+    if (!m_core->m_hostLimits.tryAcquire(host)) return false;
+    if (!m_core->m_breakers.allow(host)) {
+        m_core->m_hostLimits.release(host, MirrorHealth::Sample{});
+        return false;
+    }
+
+    auto h    = std::make_unique<Hedge>();
+    h->mem    = std::move(mem);
+    h->mirror = mirror;
+    h->path   = t->tmpPath + ".hedge";
+    QNetworkRequest req = m_core->buildRequest(url.toStdString());
+    QHttp1Configuration h1;
+    h1.setNumberOfConnectionsPerHost(m_connectionsPerHost.load());
+    req.setHttp1Configuration(h1);
+    // No resume state: the hedge is an independent full copy.
+    h->sink = std::make_unique<DownloadSink>(h->path, t->task.size, nullptr,
+                                             &m_core->m_bandwidth);
+    if (!h->sink->open(url, req)) {
+        m_core->m_hostLimits.release(host, MirrorHealth::Sample{});
+        m_core->m_breakers.abandon(host);
+        return false;
+    }
+
+    h->reply = m_nam->get(req);
+    m_core->trackConnection(h->reply);
+    h->reply->setReadBufferSize(SINK_CHUNK_BYTES);
+    h->startedAt    = m_clock.elapsed();
+    h->lastActivity = h->startedAt;
+    watch(h->reply);
+    m_hedges.emplace(h->reply, primary);
+
+    emit m_core->launchLog(QString("[Hedge] %1 is slow, racing %2: %3")
+                           .arg(t->urls.value(t->mirror), url,
+                                QString::fromStdString(t->task.path)));
+    t->hedge  = std::move(h);
+    t->hedged = true;
+    return true;
+}
+
+void DownloadEngine::onHedgeFinished(QNetworkReply* reply) {
+    QNetworkReply* primary = m_hedges.at(reply);
+    m_hedges.erase(reply);
+    auto it = m_running.find(primary);
+    Transfer* t = it->second.get();
+    std::unique_ptr<Hedge> h = std::move(t->hedge);
+
+    const QString url = t->urls.value(h->mirror);
+    const DownloadSink::Result r = h->sink->finish(reply);
+    reply->deleteLater();
+    const bool valid = r == DownloadSink::Result::Ok &&
+                       (t->task.sha1.empty() || h->sink->sha1() == t->task.sha1);
+    const MirrorHealth::Sample sample = h->sink->sample(valid);
+    m_core->m_mirrorHealth.record(QString::fromStdString(t->task.url), url, sample);
+    m_core->m_hostLimits.release(HostConcurrency::hostOf(url), sample);
+    m_core->recordHostOutcome(HostConcurrency::hostOf(url), sample);
+
+    std::error_code ec;
+    if (!valid) {
+        // Lost (or broke) – the primary simply carries on.
+        h->sink.reset();
+        fs::remove(h->path, ec);
+        return;
+    }
+    noteCompletion(sample);
+
+    // The hedge won: cancel the primary and install the hedge's copy.
+    std::unique_ptr<Transfer> owned = std::move(it->second);
+    m_running.erase(it);
+    const QString primaryHost = HostConcurrency::hostOf(owned->urls.value(owned->mirror));
+    primary->disconnect(this);
+    primary->abort();
+    primary->deleteLater();
+    m_core->m_hostLimits.release(primaryHost, MirrorHealth::Sample{});
+    m_core->m_breakers.abandon(primaryHost);
+    owned->sink.reset();
+
+    h->sink.reset();
+    std::error_code renameEc;
+    m_core->commitVerified(h->path, owned->task.path, owned->task.sha1, renameEc);
+    LauncherCore::removePartial(owned->tmpPath);
+    if (owned->sinkPath != owned->tmpPath) fs::remove(owned->sinkPath, ec);
+    if (renameEc) {
+        emit m_core->launchLog(QString("[IO] Rename failed (%1): %2")
+                               .arg(QString::fromStdString(renameEc.message()))
+                               .arg(QString::fromStdString(owned->task.path)));
+        fs::remove(h->path, ec);
+    }
+    complete(std::move(owned), !renameEc);
+}
+
+// Cancels a running hedge whose primary has already won.
+void DownloadEngine::dropHedge(Transfer* t) {
+    std::unique_ptr<Hedge> h = std::move(t->hedge);
+    m_hedges.erase(h->reply);
+    h->reply->disconnect(this);
+    h->reply->abort();
+    h->reply->deleteLater();
+    const QString host = HostConcurrency::hostOf(t->urls.value(h->mirror));
+    m_core->m_hostLimits.release(host, MirrorHealth::Sample{});
+    m_core->m_breakers.abandon(host);
+    h->sink.reset();
+    std::error_code ec;
+    fs::remove(h->path, ec);
+}
+
+void DownloadEngine::retryOrFail(std::unique_ptr<Transfer> t) {
+    if (++t->mirror < t->urls.size()) {
+        // Back to the head of the queue: the next mirror is a different host
+        // and must get its own slot from pump().
+        m_pending.push_front(std::move(t));
+        return;
+    }
+    if (t->round + 1 < m_core->m_retry.rounds) {
+        // Next round after a jittered backoff, in freshly ranked order.
+        const int delay = m_core->m_retry.backoffMs(t->round);
+        ++t->round;
+        t->mirror = 0;
+        t->urls   = m_core->candidateUrls(t->task.url, t->task.path);
+        const qint64 due = m_clock.elapsed() + delay;
+        m_delayed.emplace_back(due, std::move(t));
+        if (!m_backoff->isActive() || m_backoff->remainingTime() > delay)
+            m_backoff->start(delay);
+        return;
+    }
+    emit m_core->launchLog(QString("[Failed] All mirrors exhausted for: %1")
+                           .arg(QString::fromStdString(t->task.url)));
+    complete(std::move(t), false);
+}
+
+void DownloadEngine::complete(std::unique_ptr<Transfer> t, bool ok) {
+    m_active = static_cast<int>(m_running.size());
+    if (t->done) t->done(ok);
+}
+
+// One timer for all transfers instead of a QTimer per reply: anything that
+// has not delivered a byte for the policy's stall timeout, or has overrun
+// its size-scaled deadline, is aborted, which routes it through onFinished
+// → next mirror like any other failure.
+void DownloadEngine::sweepStalled() {
+    const qint64 now       = m_clock.elapsed();
+    const qint64 stallMs   = m_core->m_retry.stallTimeoutMs;
+    const bool   throttled = m_core->m_bandwidth.active();
+    std::vector<std::pair<QNetworkReply*, QString>> expired;
+    for (const auto& [reply, t] : m_running) {
+        if (Hedge* h = t->hedge.get()) {
+            if (h->sink->backlogged(h->reply)) h->lastActivity = now;
+            else if (now - h->lastActivity > stallMs)
+                expired.emplace_back(h->reply, QString("No data for %1 s").arg(stallMs / 1000));
+        }
+        // Held back by the bandwidth limiter, not by the server.
+        if (t->sink->backlogged(reply)) { t->lastActivity = now; continue; }
+        if (now - t->lastActivity > stallMs)
+            expired.emplace_back(reply, QString("No data for %1 s").arg(stallMs / 1000));
+        else if (!throttled && t->deadline > 0 && now > t->deadline)
+            expired.emplace_back(reply, QString("Too slow for %1 bytes").arg(t->task.size));
+    }
+    for (const auto& [reply, why] : expired) {
+        emit m_core->launchLog(QString("[Timeout] %1: %2").arg(why, reply->url().toString()));
+        reply->abort();
+    }
+    maybeHedge(now);
+    // Windows may have grown since the last completion; let queued work in.
+    if (!m_pending.empty()) pump();
+}
+
+// One shared timer for every reply the limiter is holding back: drain each
+// as far as the bucket allows and re-arm while any is still backlogged.
+void DownloadEngine::resumeThrottled() {
+    bool pending = false;
+    auto resume = [&pending](DownloadSink* sink, QNetworkReply* reply) {
+        if (!sink->backlogged(reply)) return;
+        sink->drain(reply);
+        pending = pending || sink->backlogged(reply);
+    };
+    for (const auto& [reply, t] : m_running) {
+        resume(t->sink.get(), reply);
+        if (t->hedge) resume(t->hedge->sink.get(), t->hedge->reply);
+    }
+    if (pending) m_throttle->start(static_cast<int>(m_core->m_bandwidth.waitMs()));
+}
@@ -0,0 +1,199 @@
+#ifndef DOWNLOADENGINE_H
+#define DOWNLOADENGINE_H
+
+#include <QObject>
+#include <QFile>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include "LauncherCore.h"
+#include "BandwidthLimiter.h"
+#include "MemoryBudget.h"
+#include "Sha1.h"
+
+// ════════════════════════════════════════════════════════════════════════════
+// DownloadSink – streams one reply body into a .part file
+//
+// Shared by the blocking path (LauncherCore::httpDownloadToFile) and the
+// event-driven DownloadEngine: opens / resumes the part file, adds the
+// Range / If-Range headers, hashes and writes each chunk as it is drained,
+// and classifies the outcome once the reply has finished.
+// ════════════════════════════════════════════════════════════════════════════
+
+class DownloadSink {
+public:
+    enum class Result {
+        Ok,
+        Overflow,       // Body grew past the declared size
+        Short,          // Body ended before the declared size
+        WriteError,
+        RangeMismatch,  // 206 for a range we did not ask for
+        HttpError,      // Non-2xx status
+        NetError,       // Transport error
+        Cancelled       // abort() from a timeout or the caller
+    };
+
+    DownloadSink(const std::string& tmpPath, int expectedSize,
+                 LauncherCore::PartialDownload* resume,
+                 BandwidthLimiter* limiter = nullptr);
+
+    // Opens the part file – continuing `resume` when that is safe for `url`
+    // – and adds Range / If-Range to `req`. False if the file can't be opened.
+    bool open(const QString& url, QNetworkRequest& req);
+    // Call on every readyRead; aborts the reply on overflow / write errors.
+    // Reads only what the bandwidth limiter grants – see backlogged().
+    void drain(QNetworkReply* reply);
+    // True if drain() left bytes in the reply because of the limiter; the
+    // caller must call drain() again (no readyRead comes while the buffer is
+    // full) after limiter->waitMs().
+    bool backlogged(QNetworkReply* reply) const;
+    // Call once after finished(); drains the tail and closes the file.
+    Result finish(QNetworkReply* reply);
+
+    // Log line for a failed Result (empty for Ok / Cancelled).
+    QString errorText(Result r, const QString& url) const;
+    std::string sha1() const { return m_hash.hex(); }
+    bool   headersSeen() const { return m_headersSeen; }
+    qint64 ttfbMs()      const { return m_ttfbMs; }
+    qint64 bodyBytes()   const { return m_bodyBytes; }   // This attempt only
+    qint64 received()    const { return m_received; }    // Including a resumed prefix
+    // Timing/volume/outcome of this attempt for MirrorHealth and
+    // HostConcurrency. Valid after finish().
+    MirrorHealth::Sample sample(bool ok) const;
+
+private:
+    void onHeaders(QNetworkReply* reply, int code);
+    void consume(QNetworkReply* reply, bool throttled);
+
+    std::string                    m_tmpPath;
+    int                            m_expectedSize;
+    LauncherCore::PartialDownload* m_resume;
+    BandwidthLimiter*              m_limiter;
+    QString                        m_url;
+    QFile                          m_out;
+    Sha1                           m_hash;
+    qint64                         m_offset        = 0;
+    qint64                         m_received      = 0;
+    int                            m_code          = 0;
+    QElapsedTimer                  m_clock;
+    qint64                         m_ttfbMs        = -1;
+    qint64                         m_bodyBytes     = 0;
+    QString                        m_netError;
+    QNetworkReply::NetworkError    m_netErrorCode  = QNetworkReply::NoError;
+    Result                         m_result        = Result::Ok;
+    bool                           m_headersSeen   = false;
+    bool                           m_overflow      = false;
+    bool                           m_writeError    = false;
+    bool                           m_rangeMismatch = false;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// DownloadEngine – event-driven transfer scheduler
+//
+// Lives on its own QThread with a single QNetworkAccessManager and keeps up
+// to maxInFlight transfers running concurrently through readyRead/finished
+// callbacks – no thread is parked per request. Mirror fallback, retry
+// rounds with backoff, circuit breakers and .part resume follow the same
+// rules as LauncherCore::downloadFile.
+// ════════════════════════════════════════════════════════════════════════════
+
+class DownloadEngine : public QObject {
+    Q_OBJECT
+public:
+    using Callback = std::function<void(bool ok)>;
+
+    explicit DownloadEngine(LauncherCore* core);
+    ~DownloadEngine();
+
+    // Thread-safe. Queues one file; `done` is invoked on the engine thread.
+    void submit(const LauncherCore::DownloadTask& task, Callback done);
+
+    // Thread-safe tuning. connectionsPerHost lifts Qt's default HTTP/1.1
+    // limit of 6 sockets per host so in-flight transfers aren't serialised.
+    void setMaxInFlight(int n);
+    void setConnectionsPerHost(int n);
+    // Race a duplicate request against the next mirror when a transfer
+    // falls far behind the batch's typical throughput (see maybeHedge).
+    void setHedging(bool enabled) { m_hedging = enabled; }
+    int  inFlight() const { return m_active.load(); }
+
+    // Thread-safe. Opens a kept-alive connection to each URL's host with a
+    // HEAD request, so the first transfers skip connect + TLS. `connected`
+    // runs on the engine thread with the round trip in ms (-1 = failed).
+    void prewarm(const QStringList& urls, std::function<void(const QString& host, qint64 ms)> connected);
+
+private:
+    // Duplicate request racing a slow transfer; writes its own file from 0.
+    struct Hedge {
+        QNetworkReply*                reply = nullptr;
+        std::unique_ptr<DownloadSink> sink;
+        std::string                   path;
+        int                           mirror = 0;
+        qint64                        startedAt    = 0;
+        qint64                        lastActivity = 0;
+        MemoryBudget::Lease           mem;
+    };
+
+    struct Transfer {
+        LauncherCore::DownloadTask    task;
+        QStringList                   urls;
+        int                           mirror = 0;
+        int                           round  = 0;      // Pass over the mirror list
+        std::string                   tmpPath;
+        std::string                   sinkPath;        // tmpPath, or a promoted hedge's file
+        LauncherCore::PartialDownload part;
+        std::unique_ptr<DownloadSink> sink;
+        qint64                        startedAt    = 0;
+        qint64                        lastActivity = 0;
+        qint64                        deadline     = 0;   // m_clock time; 0 = none
+        std::unique_ptr<Hedge>        hedge;
+        bool                          hedged = false;     // At most one hedge per transfer
+        MemoryBudget::Lease           mem;                // Held while a request is running
+        Callback                      done;
+    };
+
+    void ensureStarted();
+    void enqueue(std::unique_ptr<Transfer> t);
+    void pump();
+    void start(std::unique_ptr<Transfer> t);
+    void watch(QNetworkReply* reply);
+    void onReadyRead(QNetworkReply* reply);
+    void onFinished(QNetworkReply* reply);
+    void maybeHedge(qint64 now);
+    bool startHedge(Transfer* t, QNetworkReply* primary);
+    void onHedgeFinished(QNetworkReply* reply);
+    void dropHedge(Transfer* t);
+    void noteCompletion(const MirrorHealth::Sample& s);
+    void retryOrFail(std::unique_ptr<Transfer> t);
+    void complete(std::unique_ptr<Transfer> t, bool ok);
+    void sweepStalled();
+    void resumeThrottled();
+    void releaseDue();
+
+    LauncherCore*          m_core;
+    QNetworkAccessManager* m_nam = nullptr;     // Created on the engine thread
+    QTimer*                m_sweep = nullptr;
+    QTimer*                m_throttle = nullptr;   // Re-drains limiter-held replies
+    QTimer*                m_backoff  = nullptr;   // Fires when the next retry is due
+    QElapsedTimer          m_clock;
+
+    std::deque<std::unique_ptr<Transfer>>                        m_pending;
+    std::unordered_map<QNetworkReply*, std::unique_ptr<Transfer>> m_running;
+    // Transfers waiting out a retry backoff: (due m_clock time, transfer).
+    std::vector<std::pair<qint64, std::unique_ptr<Transfer>>>     m_delayed;
+    // Hedge reply → the primary reply its transfer is keyed by in m_running.
+    std::unordered_map<QNetworkReply*, QNetworkReply*>            m_hedges;
+    // Recent completed transfers, for the "well below typical" hedge test.
+    std::deque<double> m_rateSamples;   // Body bytes/s (bodies ≥ 64 KiB)
+    std::deque<double> m_ttfbSamples;   // ms
+    std::atomic<bool>  m_hedging{true};
+    std::atomic<int> m_active{0};
+    std::atomic<int> m_maxInFlight{256};
+    std::atomic<int> m_connectionsPerHost{16};
+};
+
+#endif // DOWNLOADENGINE_H
@@ -0,0 +1,120 @@
+// HostConcurrency.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Per-host AIMD concurrency windows for the download backends.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "HostConcurrency.h"
+
+#include <QMutexLocker>
+#include <QUrl>
+#include <algorithm>
+#include <cmath>
+
+// Goodput is compared window to window; one window ≈ a few RTTs of assets.
+static constexpr qint64 WINDOW_MS = 2000;
+// A window only counts as "probing higher" if the host was actually kept
+// at (or near) its limit – otherwise more slots can't explain the goodput.
+static constexpr double SATURATION = 0.8;
+// Goodput may wobble this much before an increase is treated as harmful.
+static constexpr double GOODPUT_TOLERANCE = 0.95;
+
+HostConcurrency::HostConcurrency(int initial, int minimum, int maximum)
+    : m_initial(initial), m_min(minimum), m_max(maximum) {}
+
+QString HostConcurrency::hostOf(const QString& url) {
+    return QUrl(url).host().toLower();
+}
+
+HostConcurrency::Window& HostConcurrency::windowFor(const QString& host) {
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end()) {
+        Window w;
+        w.limit = m_initial;
+        w.window.start();
+        it = m_hosts.insert(host, w);
+    }
+    return *it;
+}
+
+// 429 / 503 are explicit rate limiting, other 5xx mean the mirror is
+// struggling, resets and stalls usually mean we opened too many sockets.
+bool HostConcurrency::isCongestion(const MirrorHealth::Sample& s) {
+    if (s.httpCode == 429 || s.httpCode >= 500) return true;
+    return s.reset || s.stalled;
+}
+
+bool HostConcurrency::tryAcquire(const QString& host) {
+    QMutexLocker lk(&m_lock);
+    Window& w = windowFor(host);
+    if (w.inFlight >= static_cast<int>(w.limit)) return false;
+    ++w.inFlight;
+    w.peakInFlight = std::max(w.peakInFlight, w.inFlight);
+    return true;
+}
+
+void HostConcurrency::acquire(const QString& host) {
+    QMutexLocker lk(&m_lock);
+    for (;;) {
+        Window& w = windowFor(host);
+        if (w.inFlight < static_cast<int>(w.limit)) {
+            ++w.inFlight;
+            w.peakInFlight = std::max(w.peakInFlight, w.inFlight);
+            return;
+        }
+        m_slotFreed.wait(&m_lock);
+    }
+}
+
+void HostConcurrency::release(const QString& host, const MirrorHealth::Sample& s) {
+    QMutexLocker lk(&m_lock);
+    Window& w = windowFor(host);
+    w.inFlight = std::max(0, w.inFlight - 1);
+    if (s.ok) w.bytes += s.bytes;
+
+    if (isCongestion(s)) {
+        w.congested = true;
+        // Multiplicative decrease, once per window: a burst of 429s from
+        // one overload episode must not collapse the window to the floor.
+        if (!w.sinceDecrease.isValid() || w.sinceDecrease.elapsed() >= WINDOW_MS) {
+            w.limit = std::max<double>(m_min, std::floor(w.limit / 2));
+            w.sinceDecrease.start();
+            ++w.decreases;
+        }
+    }
+
+    if (w.window.elapsed() >= WINDOW_MS) {
+        const double goodput = w.bytes * 1000.0 / std::max<qint64>(1, w.window.elapsed());
+        const bool saturated = w.peakInFlight >= SATURATION * w.limit;
+        if (!w.congested && saturated) {
+            // Additive increase while goodput keeps up; step back if the last
+            // extra slot made things worse (the mirror is already saturated).
+            if (goodput >= w.lastGoodput * GOODPUT_TOLERANCE)
+                w.limit = std::min<double>(m_max, w.limit + 1);
+            else
+                w.limit = std::max<double>(m_min, w.limit - 1);
+        }
+        w.lastGoodput  = goodput;
+        w.bytes        = 0;
+        w.peakInFlight = w.inFlight;
+        w.congested    = false;
+        w.window.restart();
+    }
+    m_slotFreed.wakeAll();
+}
+
+std::vector<HostLimit> HostConcurrency::snapshot() const {
+    QMutexLocker lk(&m_lock);
+    std::vector<HostLimit> out;
+    for (auto it = m_hosts.cbegin(); it != m_hosts.cend(); ++it) {
+        HostLimit h;
+        h.host       = it.key().toStdString();
+        h.limit      = static_cast<int>(it->limit);
+        h.inFlight   = it->inFlight;
+        h.goodputBps = it->lastGoodput;
+        h.decreases  = it->decreases;
+        out.push_back(h);
+    }
+    std::sort(out.begin(), out.end(),
+              [](const HostLimit& a, const HostLimit& b) { return a.host < b.host; });
+    return out;
+}
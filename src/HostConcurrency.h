@@ -0,0 +1,78 @@
+#ifndef HOSTCONCURRENCY_H
+#define HOSTCONCURRENCY_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+#include <string>
+#include <vector>
+#include "MirrorHealth.h"
+
+// ════════════════════════════════════════════════════════════════════════════
+// HostLimit – one row of GET /api/download/hosts
+// ════════════════════════════════════════════════════════════════════════════
+
+struct HostLimit {
+    std::string host;
+    int         limit       = 0;   // Current concurrency window
+    int         inFlight    = 0;
+    double      goodputBps  = 0;   // Last completed measurement window
+    int         decreases   = 0;   // Congestion events acted on so far
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// HostConcurrency – AIMD parallelism controller, one window per host
+//
+// Replaces the hard-coded 16/32 thread counts. Each host starts at a small
+// window; every measurement window in which the host was kept busy and
+// goodput did not fall, the window grows by one (additive increase). A
+// 429/503, 5xx, connection reset or stall halves it (multiplicative
+// decrease, at most once per window so one burst of errors counts once).
+// Both backends gate on it: the engine with tryAcquire(), pool workers with
+// the blocking acquire(). Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class HostConcurrency {
+public:
+    HostConcurrency(int initial = 8, int minimum = 2, int maximum = 64);
+
+    // Non-blocking; true if a slot on `host` was taken.
+    bool tryAcquire(const QString& host);
+    // Blocks the calling worker until a slot on `host` is free.
+    void acquire(const QString& host);
+    // Returns the slot and feeds the outcome into the controller.
+    void release(const QString& host, const MirrorHealth::Sample& s);
+
+    int maximum() const { return m_max; }
+    std::vector<HostLimit> snapshot() const;
+
+    static QString hostOf(const QString& url);
+
+private:
+    struct Window {
+        double        limit = 0;
+        int           inFlight = 0;
+        int           peakInFlight = 0;   // Within the current measurement window
+        qint64        bytes = 0;
+        double        lastGoodput = 0;
+        bool          congested = false;
+        int           decreases = 0;
+        QElapsedTimer window;
+        QElapsedTimer sinceDecrease;
+    };
+
+    Window& windowFor(const QString& host);   // m_lock held
+    static bool isCongestion(const MirrorHealth::Sample& s);
+
+    const int m_initial;
+    const int m_min;
+    const int m_max;
+
+    mutable QMutex         m_lock;
+    QWaitCondition         m_slotFreed;
+    QHash<QString, Window> m_hosts;
+};
+
+#endif // HOSTCONCURRENCY_H
@@ -0,0 +1,85 @@
+// Http2Policy.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Per-host HTTP/2 enablement, downgrade on protocol errors, persisted.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "Http2Policy.h"
+
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSettings>
+
+static constexpr int STRIKES_TO_DOWNGRADE = 2;
+static constexpr int RETRY_AFTER_DAYS     = 7;
+
+void Http2Policy::load(const QString& iniPath) {
+    QMutexLocker lk(&m_lock);
+    m_iniPath = iniPath;
+    m_hosts.clear();
+
+    QSettings cfg(iniPath, QSettings::IniFormat);
+    m_mode = cfg.value("download/http2", "off").toString() == "auto" ? Mode::Auto : Mode::Off;
+
+    cfg.beginGroup("http2");
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (const QString& host : cfg.childKeys()) {
+        const QString v = cfg.value(host).toString();
+        HostState s;
+        if (v == "on") {
+            s.forcedOn = true;
+        } else if (v.startsWith("off")) {
+            s.pinnedAt = QDateTime::fromString(v.section('@', 1), Qt::ISODate);
+            // Expired pins get another chance this session.
+            s.pinnedOff = !s.pinnedAt.isValid() || s.pinnedAt.daysTo(now) < RETRY_AFTER_DAYS;
+        }
+        m_hosts.insert(host.toLower(), s);
+    }
+    cfg.endGroup();
+}
+
+bool Http2Policy::allowed(const QString& host) const {
+    QMutexLocker lk(&m_lock);
+    const auto it = m_hosts.constFind(host);
+    if (it != m_hosts.cend()) {
+        if (it->forcedOn)  return true;
+        if (it->pinnedOff) return false;
+    }
+    return m_mode == Mode::Auto;
+}
+
+// Transport and protocol failures count whether or not a status line
+// arrived: an RST_STREAM after the 200 headers – the mid-body reset that
+// motivates the downgrade – fails the reply with a network error while
+// its status code stays 200. Errors that merely mirror an HTTP 4xx/5xx
+// (the content and server error ranges) say nothing about the protocol,
+// and neither do our own aborts (stall timeouts, hedge cancellation),
+// which all end in OperationCanceledError.
+bool Http2Policy::record(const QString& host, const QNetworkReply* reply) {
+    if (!reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()) return false;
+    const QNetworkReply::NetworkError err = reply->error();
+    if (err == QNetworkReply::NoError || err == QNetworkReply::OperationCanceledError)
+        return false;
+    const bool transport = err < QNetworkReply::ProxyConnectionRefusedError ||
+                           (err >= QNetworkReply::ProtocolUnknownError &&
+                            err <= QNetworkReply::ProtocolFailure);
+    if (!transport) return false;
+
+    QMutexLocker lk(&m_lock);
+    HostState& s = m_hosts[host];
+    if (s.forcedOn || s.pinnedOff) return false;
+    if (++s.strikes < STRIKES_TO_DOWNGRADE) return false;
+
+    s.pinnedOff = true;
+    s.pinnedAt  = QDateTime::currentDateTimeUtc();
+    persist(host, s);
+    return true;
+}
+
+void Http2Policy::persist(const QString& host, const HostState& s) {
+    if (m_iniPath.isEmpty()) return;
+    QSettings cfg(m_iniPath, QSettings::IniFormat);
+    cfg.beginGroup("http2");
+    cfg.setValue(host, "off@" + s.pinnedAt.toString(Qt::ISODate));
+    cfg.endGroup();
+}
@@ -0,0 +1,52 @@
+#ifndef HTTP2POLICY_H
+#define HTTP2POLICY_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+class QNetworkReply;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Http2Policy – per-host HTTP/2 opt-in with automatic downgrade
+//
+// HTTP/2 used to be disabled for every request because some mirrors RST
+// streams mid-body. With [download] http2=auto in download.ini each host is
+// tried over HTTP/2 (many asset streams on one connection); after
+// STRIKES_TO_DOWNGRADE transport failures on HTTP/2 replies the host is
+// pinned to HTTP/1.1. Pins are written to the [http2] group of the same
+// file (`host=off@<ISO date>`) and re-tried after RETRY_AFTER_DAYS. A host
+// can also be forced by hand with `host=on` / `host=off`. With http2=off
+// (the default) only hosts marked `on` use HTTP/2. Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class Http2Policy {
+public:
+    enum class Mode { Off, Auto };
+
+    // Reads the mode and the [http2] host table from `iniPath`.
+    void load(const QString& iniPath);
+
+    bool allowed(const QString& host) const;
+    // Call when a reply has finished; counts protocol failures on HTTP/2.
+    // Returns true if this reply made the host fall back to HTTP/1.1.
+    bool record(const QString& host, const QNetworkReply* reply);
+
+private:
+    struct HostState {
+        bool      forcedOn   = false;
+        bool      pinnedOff  = false;
+        QDateTime pinnedAt;            // Invalid for a hand-written `off`
+        int       strikes    = 0;      // This session
+    };
+
+    void persist(const QString& host, const HostState& s);   // m_lock held
+
+    mutable QMutex            m_lock;
+    QString                   m_iniPath;
+    Mode                      m_mode = Mode::Off;
+    QHash<QString, HostState> m_hosts;
+};
+
+#endif // HTTP2POLICY_H
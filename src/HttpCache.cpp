@@ -0,0 +1,98 @@
+// HttpCache.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  On-disk ETag / Last-Modified cache for conditional metadata fetches.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "HttpCache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSaveFile>
+
+void HttpCache::setDirectory(const QString& dir) {
+    QMutexLocker lk(&m_lock);
+    m_dir = dir;
+    QDir().mkpath(dir);
+}
+
+QString HttpCache::pathFor(const QString& url) const {
+    const QByteArray key = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_dir + "/" + QString::fromLatin1(key);
+}
+
+HttpCache::Entry HttpCache::load(const QString& url) const {
+    QMutexLocker lk(&m_lock);
+    Entry e;
+    if (m_dir.isEmpty()) return e;
+    const QString base = pathFor(url);
+
+    QFile meta(base + ".json");
+    QFile body(base + ".body");
+    if (!meta.open(QIODevice::ReadOnly) || !body.open(QIODevice::ReadOnly)) return e;
+    const QJsonObject o = QJsonDocument::fromJson(meta.readAll()).object();
+    // Two URLs hashing alike is not a concern, but a truncated pair is.
+    if (o["url"].toString() != url || o["size"].toVariant().toLongLong() != body.size())
+        return e;
+
+    e.body         = body.readAll();
+    e.etag         = o["etag"].toString().toUtf8();
+    e.lastModified = o["lastModified"].toString().toUtf8();
+    e.storedAt     = QDateTime::fromString(o["storedAt"].toString(), Qt::ISODate);
+    e.valid        = !e.etag.isEmpty() || !e.lastModified.isEmpty();
+    return e;
+}
+
+void HttpCache::addValidators(const Entry& e, QNetworkRequest& req) {
+    if (!e.valid) return;
+    if (!e.etag.isEmpty())         req.setRawHeader("If-None-Match", e.etag);
+    if (!e.lastModified.isEmpty()) req.setRawHeader("If-Modified-Since", e.lastModified);
+}
+
+void HttpCache::store(const QString& url, const QByteArray& body, const QNetworkReply* reply) {
+    const QByteArray etag         = reply->rawHeader("ETag");
+    const QByteArray lastModified = reply->rawHeader("Last-Modified");
+    if (etag.isEmpty() && lastModified.isEmpty()) return;
+
+    QMutexLocker lk(&m_lock);
+    if (m_dir.isEmpty()) return;
+    const QString base = pathFor(url);
+
+    // Body first: load() rejects a meta file whose size doesn't match, so a
+    // crash between the two writes leaves a miss, never a wrong hit.
+    QSaveFile bf(base + ".body");
+    if (!bf.open(QIODevice::WriteOnly)) return;
+    bf.write(body);
+    if (!bf.commit()) return;
+
+    QJsonObject o;
+    o["url"]          = url;
+    o["etag"]         = QString::fromUtf8(etag);
+    o["lastModified"] = QString::fromUtf8(lastModified);
+    o["size"]         = static_cast<double>(body.size());
+    o["storedAt"]     = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    QSaveFile mf(base + ".json");
+    if (!mf.open(QIODevice::WriteOnly)) return;
+    mf.write(QJsonDocument(o).toJson(QJsonDocument::Compact));
+    mf.commit();
+}
+
+void HttpCache::touch(const QString& url) {
+    QMutexLocker lk(&m_lock);
+    if (m_dir.isEmpty()) return;
+    const QString path = pathFor(url) + ".json";
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return;
+    QJsonObject o = QJsonDocument::fromJson(f.readAll()).object();
+    f.close();
+    o["storedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    QSaveFile mf(path);
+    if (!mf.open(QIODevice::WriteOnly)) return;
+    mf.write(QJsonDocument(o).toJson(QJsonDocument::Compact));
+    mf.commit();
+}
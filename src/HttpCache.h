@@ -0,0 +1,49 @@
+#ifndef HTTPCACHE_H
+#define HTTPCACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QMutex>
+#include <QString>
+
+class QNetworkRequest;
+class QNetworkReply;
+
+// ════════════════════════════════════════════════════════════════════════════
+// HttpCache – persistent validator cache for metadata GETs
+//
+// version_manifest*.json and the Java runtime all.json change rarely but are
+// several hundred KiB. Each cached URL keeps its last 200 body plus ETag /
+// Last-Modified under workDir/cache/http (<sha1(url)>.body / .json). The next
+// fetch sends If-None-Match / If-Modified-Since, so an unchanged document
+// costs a 304 with no body. Thread-safe; writes are atomic (QSaveFile).
+// ════════════════════════════════════════════════════════════════════════════
+
+class HttpCache {
+public:
+    struct Entry {
+        bool       valid = false;
+        QByteArray body;
+        QByteArray etag;
+        QByteArray lastModified;
+        QDateTime  storedAt;
+    };
+
+    void setDirectory(const QString& dir);
+
+    Entry load(const QString& url) const;
+    // Adds the conditional headers for a cached entry (no-op if invalid).
+    static void addValidators(const Entry& e, QNetworkRequest& req);
+    // Stores a 2xx response. Responses without any validator are not kept.
+    void store(const QString& url, const QByteArray& body, const QNetworkReply* reply);
+    // A 304 confirmed the entry; refresh its timestamp.
+    void touch(const QString& url);
+
+private:
+    QString pathFor(const QString& url) const;   // Without extension
+
+    mutable QMutex m_lock;
+    QString        m_dir;
+};
+
+#endif // HTTPCACHE_H
@@ -8,6 +8,17 @@
 #include <iostream>
 #include <utility> // for std::as_const
 
+static QJsonObject transferJson(const DownloadProgress& p) {
+    QJsonObject o;
+    o["filesDone"]   = p.filesDone;
+    o["filesTotal"]  = p.filesTotal;
+    o["bytesDone"]   = static_cast<double>(p.bytesDone);
+    o["bytesTotal"]  = static_cast<double>(p.bytesTotal);
+    o["bytesPerSec"] = p.bytesPerSec;
+    o["etaMs"]       = static_cast<double>(p.etaMs);
+    return o;
+}
+
 HttpServer::HttpServer(QObject *parent) 
     : QTcpServer(parent), launcher(nullptr) 
 {
@@ -38,6 +49,7 @@ void HttpServer::setLauncher(LauncherCore* core) {
         connect(launcher, &LauncherCore::javaFinished,        this, &HttpServer::broadcastJavaFinished);
         connect(launcher, &LauncherCore::mcDownloadProgress,  this, &HttpServer::broadcastMcDownloadProgress);
         connect(launcher, &LauncherCore::mcDownloadFinished,  this, &HttpServer::broadcastMcDownloadFinished);
+        connect(launcher, &LauncherCore::downloadProgress,    this, &HttpServer::broadcastDownloadProgress);
     }
 }
 
@@ -112,6 +124,23 @@ void HttpServer::broadcastMcDownloadFinished(bool success, QString versionId, QS
 #endif
 }
 
+// Already rate-limited at the source (ProgressMeter, 10 Hz per batch).
+void HttpServer::broadcastDownloadProgress(QString job, qint64 bytesDone, qint64 bytesTotal,
+                                           double bytesPerSec, qint64 etaMs) {
+#ifdef NMCL_USE_WEBSOCKETS
+    QJsonObject obj;
+    obj["type"]        = "download_progress";
+    obj["job"]         = job;
+    obj["bytesDone"]   = static_cast<double>(bytesDone);
+    obj["bytesTotal"]  = static_cast<double>(bytesTotal);
+    obj["bytesPerSec"] = bytesPerSec;
+    obj["etaMs"]       = static_cast<double>(etaMs);
+    QString text = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    for (QWebSocket *pClient : std::as_const(clients))
+        pClient->sendTextMessage(text);
+#endif
+}
+
 void HttpServer::incomingConnection(qintptr socketDescriptor) {
     QTcpSocket *socket = new QTcpSocket(this);
     if (!socket->setSocketDescriptor(socketDescriptor)) {
@@ -209,6 +238,7 @@ void HttpServer::incomingConnection(qintptr socketDescriptor) {
                  obj["message"] = QString::fromStdString(status.statusMsg);
                  obj["success"] = status.success;
                  obj["error"] = QString::fromStdString(status.error);
+                 obj["transfer"] = transferJson(status.transfer);
                  responseBody = QJsonDocument(obj).toJson();
              } else {
                  responseBody = "{}";
@@ -324,11 +354,249 @@ void HttpServer::incomingConnection(qintptr socketDescriptor) {
                 obj["message"]    = QString::fromStdString(s.statusMsg);
                 obj["success"]    = s.success;
                 obj["error"]      = QString::fromStdString(s.error);
+                obj["transfer"]   = transferJson(s.transfer);
                 responseBody = QJsonDocument(obj).toJson();
             } else {
                 responseBody = "{}";
             }
         }
+        else if (method == "GET" && url == "/api/download/mirrors") {
+            // Live mirror ranking (best first within each host family)
+            contentType = "application/json";
+            if (launcher) {
+                QJsonArray arr;
+                for (const auto& m : launcher->getMirrorHealth()) {
+                    QJsonObject obj;
+                    obj["family"]        = QString::fromStdString(m.family);
+                    obj["mirror"]        = QString::fromStdString(m.mirror);
+                    obj["throughputBps"] = m.throughputBps;
+                    obj["ttfbMs"]        = m.ttfbMs;
+                    obj["errorRate"]     = m.errorRate;
+                    obj["samples"]       = m.samples;
+                    obj["cost"]          = m.cost;
+                    arr.append(obj);
+                }
+                responseBody = QJsonDocument(arr).toJson();
+            } else {
+                responseBody = "[]";
+            }
+        }
+        else if (method == "GET" && url == "/api/download/hosts") {
+            // Current AIMD concurrency window per download host
+            contentType = "application/json";
+            if (launcher) {
+                QJsonArray arr;
+                for (const auto& h : launcher->getHostLimits()) {
+                    QJsonObject obj;
+                    obj["host"]       = QString::fromStdString(h.host);
+                    obj["limit"]      = h.limit;
+                    obj["inFlight"]   = h.inFlight;
+                    obj["goodputBps"] = h.goodputBps;
+                    obj["decreases"]  = h.decreases;
+                    arr.append(obj);
+                }
+                responseBody = QJsonDocument(arr).toJson();
+            } else {
+                responseBody = "[]";
+            }
+        }
+        else if (method == "GET" && url == "/api/download/bandwidth") {
+            // Global rate limit: configured rate, schedule and the rate in force now
+            contentType = "application/json";
+            QJsonObject obj;
+            if (launcher) {
+                const BandwidthStatus b = launcher->getBandwidthStatus();
+                obj["rateBytesPerSec"]      = static_cast<double>(b.rateBps);
+                obj["effectiveBytesPerSec"] = static_cast<double>(b.effectiveBps);
+                obj["schedule"]             = QString::fromStdString(b.schedule);
+                obj["bytesTotal"]           = static_cast<double>(b.bytesTotal);
+            }
+            responseBody = QJsonDocument(obj).toJson();
+        }
+        else if (method == "POST" && url == "/api/download/bandwidth") {
+            // Live adjustment; either field may be omitted
+            // {"rateBytesPerSec": 2097152, "schedule": "09:00-18:00=512K"}
+            contentType = "application/json";
+            QStringList parts = requestStr.split("\r\n\r\n");
+            QString body = parts.size() > 1 ? parts.last() : "";
+            if (body.isEmpty()) { parts = requestStr.split("\n\n"); body = parts.size() > 1 ? parts.last() : ""; }
+
+            QJsonObject req = QJsonDocument::fromJson(body.toUtf8()).object();
+            QJsonObject resp;
+            if (!launcher) {
+                resp["success"] = false;
+                resp["message"] = "无效参数";
+            } else if (req.contains("schedule") &&
+                       !launcher->setBandwidthSchedule(req["schedule"].toString())) {
+                resp["success"] = false;
+                resp["message"] = "时间表格式错误 (HH:MM-HH:MM=速率[K|M],...)";
+            } else {
+                if (req.contains("rateBytesPerSec"))
+                    launcher->setBandwidthLimit(static_cast<qint64>(req["rateBytesPerSec"].toDouble()));
+                const BandwidthStatus b = launcher->getBandwidthStatus();
+                resp["success"]              = true;
+                resp["rateBytesPerSec"]      = static_cast<double>(b.rateBps);
+                resp["effectiveBytesPerSec"] = static_cast<double>(b.effectiveBps);
+                resp["schedule"]             = QString::fromStdString(b.schedule);
+            }
+            responseBody = QJsonDocument(resp).toJson();
+        }
+        else if (method == "GET" && url == "/api/download/memory") {
+            // In-flight memory ceiling and how much of it transfers hold now / at peak
+            contentType = "application/json";
+            QJsonObject obj;
+            if (launcher) {
+                const MemoryStatus m = launcher->getMemoryStatus();
+                obj["limitBytes"] = static_cast<double>(m.limitBytes);
+                obj["inUseBytes"] = static_cast<double>(m.inUseBytes);
+                obj["peakBytes"]  = static_cast<double>(m.peakBytes);
+                obj["transfers"]  = m.leases;
+                obj["waiting"]    = m.waiting;
+            }
+            responseBody = QJsonDocument(obj).toJson();
+        }
+        else if (method == "POST" && url == "/api/download/memory") {
+            // {"limitBytes": 67108864}; 0 = unlimited
+            contentType = "application/json";
+            QStringList parts = requestStr.split("\r\n\r\n");
+            QString body = parts.size() > 1 ? parts.last() : "";
+            if (body.isEmpty()) { parts = requestStr.split("\n\n"); body = parts.size() > 1 ? parts.last() : ""; }
+
+            QJsonObject req = QJsonDocument::fromJson(body.toUtf8()).object();
+            QJsonObject resp;
+            if (!launcher || !req.contains("limitBytes")) {
+                resp["success"] = false;
+                resp["message"] = "无效参数";
+            } else {
+                launcher->setMemoryBudget(static_cast<qint64>(req["limitBytes"].toDouble()));
+                resp["success"]    = true;
+                resp["limitBytes"] = static_cast<double>(launcher->getMemoryStatus().limitBytes);
+            }
+            responseBody = QJsonDocument(resp).toJson();
+        }
+        else if (method == "GET" && url == "/api/download/segments") {
+            // Multi-range download of large files: size threshold and ranges per file
+            contentType = "application/json";
+            QJsonObject obj;
+            if (launcher) {
+                obj["thresholdBytes"] = static_cast<double>(launcher->getSegmentThreshold());
+                obj["segments"]       = launcher->getSegmentCount();
+            }
+            responseBody = QJsonDocument(obj).toJson();
+        }
+        else if (method == "POST" && url == "/api/download/segments") {
+            // {"thresholdBytes": 16777216, "segments": 4}; thresholdBytes <= 0 disables
+            contentType = "application/json";
+            QStringList parts = requestStr.split("\r\n\r\n");
+            QString body = parts.size() > 1 ? parts.last() : "";
+            if (body.isEmpty()) { parts = requestStr.split("\n\n"); body = parts.size() > 1 ? parts.last() : ""; }
+
+            QJsonObject req = QJsonDocument::fromJson(body.toUtf8()).object();
+            QJsonObject resp;
+            if (!launcher || (!req.contains("thresholdBytes") && !req.contains("segments"))) {
+                resp["success"] = false;
+                resp["message"] = "无效参数";
+            } else {
+                const qint64 threshold = req.contains("thresholdBytes")
+                    ? static_cast<qint64>(req["thresholdBytes"].toDouble())
+                    : launcher->getSegmentThreshold();
+                const int segments = req.contains("segments") ? req["segments"].toInt()
+                                                              : launcher->getSegmentCount();
+                launcher->setSegmentedDownload(threshold, segments);
+                resp["success"]        = true;
+                resp["thresholdBytes"] = static_cast<double>(launcher->getSegmentThreshold());
+                resp["segments"]       = launcher->getSegmentCount();
+            }
+            responseBody = QJsonDocument(resp).toJson();
+        }
+        else if (method == "GET" && url == "/api/download/backend") {
+            // Transfer backend used by batch downloads
+            contentType = "application/json";
+            QJsonObject obj;
+            if (launcher)
+                obj["backend"] = launcher->getDownloadBackend() == LauncherCore::DownloadBackend::Async
+                               ? "async" : "threads";
+            responseBody = QJsonDocument(obj).toJson();
+        }
+        else if (method == "POST" && url == "/api/download/backend") {
+            // {"backend": "async" | "threads"}; applies from the next batch
+            contentType = "application/json";
+            QStringList parts = requestStr.split("\r\n\r\n");
+            QString body = parts.size() > 1 ? parts.last() : "";
+            if (body.isEmpty()) { parts = requestStr.split("\n\n"); body = parts.size() > 1 ? parts.last() : ""; }
+
+            QJsonObject req = QJsonDocument::fromJson(body.toUtf8()).object();
+            const QString backend = req["backend"].toString();
+            QJsonObject resp;
+            if (!launcher || (backend != "async" && backend != "threads")) {
+                resp["success"] = false;
+                resp["message"] = "无效参数";
+            } else {
+                launcher->setDownloadBackend(backend == "async"
+                                             ? LauncherCore::DownloadBackend::Async
+                                             : LauncherCore::DownloadBackend::ThreadPool);
+                resp["success"] = true;
+                resp["backend"] = backend;
+            }
+            responseBody = QJsonDocument(resp).toJson();
+        }
+        else if (method == "GET" && url == "/api/download/verify") {
+            // Verification mode and the background SHA-1 pass after a fast launch
+            contentType = "application/json";
+            QJsonObject obj;
+            if (launcher) {
+                const IntegrityStatus st = launcher->getIntegrityStatus();
+                obj["mode"]           = launcher->getVerifyMode() == LauncherCore::VerifyMode::Fast
+                                      ? "fast" : "full";
+                obj["running"]        = st.running;
+                obj["versionId"]      = QString::fromStdString(st.versionId);
+                obj["checked"]        = st.checked;
+                obj["total"]          = st.total;
+                obj["corrupt"]        = st.corrupt;
+                obj["pendingRepairs"] = st.pendingRepairs;
+            }
+            responseBody = QJsonDocument(obj).toJson();
+        }
+        else if (method == "POST" && url == "/api/download/verify") {
+            // {"mode": "fast" | "full"}
+            contentType = "application/json";
+            QStringList parts = requestStr.split("\r\n\r\n");
+            QString body = parts.size() > 1 ? parts.last() : "";
+            if (body.isEmpty()) { parts = requestStr.split("\n\n"); body = parts.size() > 1 ? parts.last() : ""; }
+
+            QJsonObject req = QJsonDocument::fromJson(body.toUtf8()).object();
+            const QString mode = req["mode"].toString();
+            QJsonObject resp;
+            if (!launcher || (mode != "fast" && mode != "full")) {
+                resp["success"] = false;
+                resp["message"] = "无效参数";
+            } else {
+                launcher->setVerifyMode(mode == "fast" ? LauncherCore::VerifyMode::Fast
+                                                       : LauncherCore::VerifyMode::Full);
+                resp["success"] = true;
+                resp["mode"]    = mode;
+            }
+            responseBody = QJsonDocument(resp).toJson();
+        }
+        else if (method == "GET" && url == "/api/download/warmup") {
+            // Startup DNS answers (TTL, re-resolves) and pre-connect time per host
+            contentType = "application/json";
+            QJsonArray arr;
+            if (launcher) {
+                for (const WarmHost& w : launcher->getWarmupStatus()) {
+                    QJsonObject obj;
+                    obj["host"]      = QString::fromStdString(w.host);
+                    obj["addresses"] = w.addresses;
+                    obj["dnsMs"]     = static_cast<double>(w.dnsMs);
+                    obj["ttlSec"]    = w.ttlSec;
+                    obj["connectMs"] = static_cast<double>(w.connectMs);
+                    obj["ageMs"]     = static_cast<double>(w.ageMs);
+                    obj["refreshes"] = w.refreshes;
+                    arr.append(obj);
+                }
+            }
+            responseBody = QJsonDocument(arr).toJson();
+        }
         else if (method == "POST" && url == "/api/versions/isolation") {
             contentType = "application/json";
             QStringList parts = requestStr.split("\r\n\r\n");
@@ -30,6 +30,8 @@ private slots:
     void broadcastJavaFinished(bool success, QString error);
     void broadcastMcDownloadProgress(int percent, QString message);
     void broadcastMcDownloadFinished(bool success, QString versionId, QString error);
+    void broadcastDownloadProgress(QString job, qint64 bytesDone, qint64 bytesTotal,
+                                   double bytesPerSec, qint64 etaMs);
 
 private:
     LauncherCore* launcher;
@@ -19,12 +19,17 @@
 //   8. stepWait             (McLaunchWait)
 
 #include "LauncherCore.h"
+#include "DownloadEngine.h"
+#include "Sha1.h"
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <climits>
 #include <filesystem>
 #include <set>
 #include <atomic>
+#include <memory>
 
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -35,7 +40,6 @@
 #include <QProcess>
 #include <QStandardPaths>
 #include <QFileInfo>
-#include <QCryptographicHash>
 #include <QSettings>
 #include <QStringList>
 #include <QSysInfo>
@@ -46,22 +50,67 @@
 #include <QPointer>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QWaitCondition>
+#include <QSaveFile>
+#include <QUrl>
 
 #ifdef Q_OS_WIN
 #  include <windows.h>
 #endif
+#ifdef Q_OS_LINUX
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
+// " (3.2 MiB/s, ~12 s left)" for progress messages; empty until measured.
+static QString transferSuffix(const DownloadProgress& p) {
+    if (p.finished || p.bytesPerSec < 1) return {};
+    QString s = QString(" (%1 MiB/s").arg(p.bytesPerSec / (1024.0 * 1024.0), 0, 'f', 1);
+    if (p.etaMs >= 0) s += QString(", ~%1 s left").arg((p.etaMs + 999) / 1000);
+    return s + ")";
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Construction / Init
 // ════════════════════════════════════════════════════════════════════════════
 
 LauncherCore::LauncherCore(QObject* parent) : QObject(parent) {
     networkManager = new QNetworkAccessManager(this);
+    // Keep idle workers (and their warm connections) around between the
+    // phases of an install instead of Qt's default 30 s.
+    m_downloadPool.setExpiryTimeout(120000);
+    connect(&m_warmupTimer, &QTimer::timeout, this, &LauncherCore::refreshWarmupAsync);
+
+    // The async engine owns its QNetworkAccessManager on a dedicated thread.
+    m_engine = new DownloadEngine(this);
+    m_engine->moveToThread(&m_engineThread);
+    m_engineThread.setObjectName("DownloadEngine");
+    m_engineThread.start();
 }
 
-LauncherCore::~LauncherCore() {}
+LauncherCore::~LauncherCore() {
+    m_warmupTimer.stop();
+    m_warmupRefresh.waitForFinished();
+    if (m_deepCheck) {
+        m_deepCheckStop = true;
+        m_deepCheck->wait();
+        delete m_deepCheck;
+        m_deepCheck = nullptr;
+    }
+    // The engine, its QNetworkAccessManager and timers belong to the engine
+    // thread; destroy them there while its event loop still runs.
+    DownloadEngine* engine = m_engine;
+    m_engine = nullptr;
+    QMetaObject::invokeMethod(engine, [engine]() { delete engine; },
+                              Qt::BlockingQueuedConnection);
+    m_engineThread.quit();
+    m_engineThread.wait();
+    m_verified.save();
+}
 
 void LauncherCore::init(const std::string& dir) {
     workDir = dir;
@@ -70,6 +119,105 @@ void LauncherCore::init(const std::string& dir) {
     fs::create_directories(fs::path(workDir) / "assets" / "indexes");
     fs::create_directories(fs::path(workDir) / "assets" / "objects");
     fs::create_directories(fs::path(workDir) / "runtime");
+    m_httpCache.setDirectory(QString::fromStdString(workDir) + "/cache/http");
+    m_verified.load(QString::fromStdString(workDir) + "/cache/verified.idx");
+    m_repairs.load(QString::fromStdString(workDir) + "/cache/repair.list");
+
+    // ── Download tuning (workDir/download.ini) ───────────────────────────────
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    m_segmentThreshold = cfg.value("segmentThresholdBytes",
+                                   static_cast<qint64>(m_segmentThreshold)).toLongLong();
+    m_segmentCount     = std::clamp(cfg.value("segments", m_segmentCount.load()).toInt(), 1, 16);
+    m_backend = cfg.value("backend", "async").toString() == "threads"
+              ? DownloadBackend::ThreadPool : DownloadBackend::Async;
+    m_engine->setMaxInFlight(cfg.value("maxInFlight", 256).toInt());
+    m_engine->setConnectionsPerHost(cfg.value("connectionsPerHost", 16).toInt());
+    m_engine->setHedging(cfg.value("hedging", true).toBool());
+    m_retry.rounds          = std::clamp(cfg.value("retryRounds", m_retry.rounds).toInt(), 1, 10);
+    m_retry.baseDelayMs     = cfg.value("retryBaseDelayMs", m_retry.baseDelayMs).toInt();
+    m_retry.maxDelayMs      = cfg.value("retryMaxDelayMs", m_retry.maxDelayMs).toInt();
+    m_retry.stallTimeoutMs  = std::max(1000, cfg.value("stallTimeoutMs", m_retry.stallTimeoutMs).toInt());
+    m_retry.floorBps        = cfg.value("minThroughputBps", m_retry.floorBps).toLongLong();
+    m_breakers.configure(cfg.value("breakerFailures", 5).toInt(),
+                         cfg.value("breakerCooldownMs", 30000).toInt(),
+                         cfg.value("breakerMaxCooldownMs", 300000).toInt());
+    m_memory.setLimit(cfg.value("memoryBudgetBytes", 0).toLongLong());
+    m_bandwidth.setRate(cfg.value("rateLimitBytesPerSec", 0).toLongLong());
+    if (!m_bandwidth.setSchedule(cfg.value("rateSchedule").toString()))
+        emit launchLog("[Config] Ignoring malformed download.ini rateSchedule");
+    m_localMirrors.configure(cfg.value("localMirrors").toStringList(),
+                             QString::fromStdString(workDir));
+    const bool warmup = cfg.value("warmup", true).toBool();
+    m_verifyMode = cfg.value("verifyMode", "full").toString() == "fast"
+                 ? VerifyMode::Fast : VerifyMode::Full;
+    const int verifyDepth = std::clamp(cfg.value("verifyDepth", 0).toInt(), 0, 64);
+    m_verifyPool.setMaxThreadCount(verifyDepth > 0 ? verifyDepth
+                                                   : std::max(4, QThread::idealThreadCount()));
+    cfg.endGroup();
+    for (const QString& root : m_localMirrors.roots())
+        emit launchLog(QString("[Mirror] Local mirror: %1").arg(root));
+    emit launchLog(QString("[IO] SHA-1 kernel: %1").arg(Sha1::name(Sha1::best())));
+    m_segmentPool.setMaxThreadCount(16);
+    m_http2.load(QString::fromStdString(workDir) + "/download.ini");
+
+    // Resolve every mirror host in parallel off the main thread, then open
+    // connections once the addresses are cached.
+    if (warmup) {
+        QPointer<LauncherCore> self(this);
+        const QStringList urls = warmupUrls();
+        (void)QtConcurrent::run([self, urls]() {
+            if (!self) return;
+            QStringList hosts;
+            for (const QString& u : urls) hosts << QUrl(u).host();
+            hosts.removeDuplicates();
+            self->m_warmup.resolve(hosts);
+            if (self) QMetaObject::invokeMethod(self, [self, urls]() {
+                if (!self) return;
+                self->prewarmConnections(urls);
+                self->m_warmupTimer.start(WARMUP_REFRESH_MS);
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void LauncherCore::refreshWarmupAsync() {
+    // A slow resolver can outlast the interval; never stack refreshes.
+    if (m_warmupRefresh.isRunning()) return;
+    m_warmupRefresh = QtConcurrent::run([this]() { m_warmup.refreshExpired(); });
+}
+
+void LauncherCore::setSegmentedDownload(qint64 thresholdBytes, int segments) {
+    m_segmentThreshold = thresholdBytes;
+    m_segmentCount     = std::clamp(segments, 1, 16);
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("segmentThresholdBytes", thresholdBytes);
+    cfg.setValue("segments", m_segmentCount.load());
+    cfg.endGroup();
+}
+
+void LauncherCore::setDownloadBackend(DownloadBackend backend) {
+    m_backend = backend;
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("backend", backend == DownloadBackend::Async ? "async" : "threads");
+    cfg.endGroup();
+}
+
+void LauncherCore::setVerifyMode(VerifyMode mode) {
+    m_verifyMode = mode;
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("verifyMode", mode == VerifyMode::Fast ? "fast" : "full");
+    cfg.endGroup();
+}
+
+IntegrityStatus LauncherCore::getIntegrityStatus() const {
+    QMutexLocker lk(&m_integrityLock);
+    IntegrityStatus s = m_integrity;
+    s.pendingRepairs  = static_cast<int>(m_repairs.entries().size());
+    return s;
 }
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -346,7 +494,7 @@ QString LauncherCore::fetchManifestUrl(const QString& component,
     };
     QByteArray allJson;
     for (const QString& url : allJsonUrls) {
-        allJson = httpGet(url.toStdString(), nullptr, nam);
+        allJson = httpGet(url.toStdString(), nullptr, nam, true);
         if (!allJson.isEmpty()) break;
     }
     if (allJson.isEmpty()) return {};
@@ -451,8 +599,8 @@ void LauncherCore::installJava(int majorVersion) {
         // ════════════════════════════════════════════════════════════════════
         // Phase 1 – JavaFileList
         //   Fetch all.json → locate component manifest URL → parse file list.
-        //   Each file is compared against what's on disk; valid files are
-        //   skipped to support resume / incremental update.
+        //   Files already valid on disk are skipped by batchDownload's
+        //   verification stage, which supports resume / incremental update.
         // ════════════════════════════════════════════════════════════════════
         safeEmit([](LauncherCore* p){ emit p->javaPhaseChanged(1, "Fetching file list"); });
         progress(0, "Connecting to Mojang...");
@@ -488,22 +636,17 @@ void LauncherCore::installJava(int majorVersion) {
         fs::create_directories(fs::path(targetDir));
 
         int totalFiles = files.size();
-        // Track counts atomically so the progress lambda (called from pool
-        // threads inside batchDownload) can read them safely.
-        std::atomic<int> skipped{0};
         std::vector<DownloadTask> tasks;
         tasks.reserve(static_cast<size_t>(totalFiles));
 
+        // Files are not checked here: batchDownload verifies them across
+        // m_verifyPool and queues each one that fails as soon as it is found,
+        // so a warm re-install costs one parallel pass instead of a serial
+        // hash of every file before the first download starts.
         for (const JavaManifestFile& f : files) {
             std::string localPath =
                 (fs::path(targetDir) / f.path.toStdString()).string();
 
-            // validateFile checks size first (cheap), then SHA1 (expensive).
-            // Files that pass are already good – no need to re-download.
-            bool valid = false;
-            if (self) valid = self->validateFile(localPath, f.size, f.sha1.toStdString());
-            if (valid) { skipped.fetch_add(1, std::memory_order_relaxed); continue; }
-
             // FIX(Bug2): Pass the original Mojang URL so buildMirrorUrls can
             // generate the full three-way fallback chain:
             //   1. bmclapi2.bangbang93.com  (fastest in CN)
@@ -516,14 +659,7 @@ void LauncherCore::installJava(int majorVersion) {
                               f.sha1.toStdString() });
         }
 
-        {
-            int skip = skipped.load();
-            if (skip > 0)
-                progress((skip * 90) / totalFiles,
-                         QString("%1 / %2 files already up to date.")
-                         .arg(skip).arg(totalFiles));
-        }
-        progress(5, QString("Need to download %1 file(s)...").arg(tasks.size()));
+        progress(5, QString("Checking %1 file(s)...").arg(tasks.size()));
 
         // ════════════════════════════════════════════════════════════════════
         // Phase 2 – JavaDownloadLoader
@@ -537,25 +673,29 @@ void LauncherCore::installJava(int majorVersion) {
         // ════════════════════════════════════════════════════════════════════
         safeEmit([](LauncherCore* p){ emit p->javaPhaseChanged(2, "Downloading Java runtime"); });
 
-        // Capture skipped by value for the lambda (it's already done being written)
-        const int skippedCount = skipped.load();
-
         if (!tasks.empty()) {
             bool ok = false;
             if (self) {
-                ok = self->batchDownload(tasks, 16, // FIX(Bug3): reduced from 32 to avoid BMCLAPI rate-limiting at high progress
-                    [&progress, skippedCount, totalFiles](int done, int taskTotal) {
-                        int overall = skippedCount + done;
-                        // Always fire on the last file so progress reaches ~90%
-                        // exactly, not just on multiples of 10.
-                        bool shouldReport = (done % 5 == 0) || (done == taskTotal);
-                        if (shouldReport) {
-                            // Scale download phase to 5–90% of total bar
-                            int pct = 5 + (overall * 85) / totalFiles;
-                            progress(pct,
-                                QString("Downloading %1 / %2 files...")
-                                .arg(overall).arg(totalFiles));
-                        }
+                // Parallelism per mirror is adapted by HostConcurrency (AIMD),
+                // which backs off on BMCLAPI 429s instead of a fixed 16.
+                // Reports arrive at most 10×/s (see ProgressMeter), weighted
+                // by bytes so the few large modules don't stall the bar.
+                ok = self->batchDownload(tasks,
+                    [&progress, &safeEmit, totalFiles](const DownloadProgress& p) {
+                        safeEmit([&](LauncherCore* core){
+                            QMutexLocker l(&core->m_javaStatusLock);
+                            core->m_javaStatus.transfer = p;
+                        });
+                        // Scale download phase to 5–90% of total bar
+                        int pct = 5 + (p.percent() * 85) / 100;
+                        progress(pct,
+                            QString("Checked / downloaded %1 / %2 files...%3")
+                            .arg(p.filesDone).arg(totalFiles)
+                            .arg(transferSuffix(p)));
+                        safeEmit([&](LauncherCore* core){
+                            emit core->downloadProgress("java", p.bytesDone, p.bytesTotal,
+                                                        p.bytesPerSec, p.etaMs);
+                        });
                     });
             }
 
@@ -679,29 +819,158 @@ QStringList LauncherCore::buildMirrorUrls(const QString& original) const {
         urls << m;
         if (m != original) urls << original;
     }
+    // Static order is only the prior; live scores decide who goes first.
+    return m_mirrorHealth.rank(original, urls);
+}
+
+// LAN mirrors are not ranked: they are local by configuration and always
+// go first. A file they don't have costs one 404 on the LAN.
+QStringList LauncherCore::candidateUrls(const std::string& url, const std::string& path) const {
+    return m_localMirrors.urlsFor(path) + buildMirrorUrls(QString::fromStdString(url));
+}
+
+// ── Startup warm-up ─────────────────────────────────────────────────────────
+// One URL per host that buildMirrorUrls can hand out; the root path is
+// enough, since only the connection is wanted.
+QStringList LauncherCore::warmupUrls() const {
+    QStringList urls;
+    for (const char* host : { "piston-meta.mojang.com", "launchermeta.mojang.com",
+                              "launcher.mojang.com", "piston-data.mojang.com",
+                              "resources.download.minecraft.net", "libraries.minecraft.net",
+                              "bmclapi2.bangbang93.com", "download.mcbbs.net" })
+        urls << QString("https://%1/").arg(host);
+    for (const QString& root : m_localMirrors.roots()) {
+        const QUrl u(root);
+        if (u.scheme().startsWith("http")) urls << u.adjusted(QUrl::RemovePath).toString() + "/";
+    }
     return urls;
 }
 
+void LauncherCore::prewarmConnections(const QStringList& urls) {
+    QPointer<LauncherCore> self(this);
+    m_engine->prewarm(urls, [self](const QString& host, qint64 ms) {
+        if (!self) return;
+        self->m_warmup.recordConnect(host, ms);
+        for (const WarmHost& w : self->m_warmup.status()) {
+            if (QString::fromStdString(w.host) != host) continue;
+            emit self->launchLog(QString("[Warmup] %1: DNS %2 ms (TTL %3 s), connect+TLS %4")
+                .arg(host).arg(w.dnsMs).arg(w.ttlSec)
+                .arg(ms < 0 ? QString("failed") : QString("%1 ms").arg(ms)));
+        }
+    });
+    // Manifest and version JSON requests go through networkManager's own pool.
+    for (const QString& url : urls) {
+        if (!url.contains("meta.mojang.com") && !url.contains("bmclapi2")) continue;
+        QNetworkRequest req = buildRequest(url.toStdString());
+        req.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::ManualRedirectPolicy);
+        QNetworkReply* reply = networkManager->head(req);
+        connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+    }
+}
+
+bool LauncherCore::placeFromLocal(const std::string& path, int size, const std::string& sha1) {
+    const std::string tmp = path + ".local";
+    for (const std::string& src : m_localMirrors.filesFor(path)) {
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+        if (!m_localMirrors.materialise(src, tmp)) continue;
+        if (validateFile(tmp, size, sha1) && commitVerified(tmp, path, sha1, ec)) {
+            removePartial(path + ".part");
+            return true;
+        }
+        emit launchLog(QString("[Local] %1 does not match, ignoring it")
+                       .arg(QString::fromStdString(src)));
+        fs::remove(tmp, ec);
+    }
+    return false;
+}
+
+std::vector<MirrorScore> LauncherCore::getMirrorHealth() const {
+    return m_mirrorHealth.snapshot();
+}
+
+std::vector<HostLimit> LauncherCore::getHostLimits() const {
+    return m_hostLimits.snapshot();
+}
+
+void LauncherCore::recordHostOutcome(const QString& host, const MirrorHealth::Sample& s) {
+    switch (m_breakers.record(host, s)) {
+        case CircuitBreakers::Transition::Opened:
+            emit launchLog(QString("[Breaker] %1 keeps failing, pausing requests to it").arg(host));
+            break;
+        case CircuitBreakers::Transition::Closed:
+            emit launchLog(QString("[Breaker] %1 is answering again").arg(host));
+            break;
+        case CircuitBreakers::Transition::None:
+            break;
+    }
+}
+
+void LauncherCore::setBandwidthLimit(qint64 bytesPerSec) {
+    m_bandwidth.setRate(bytesPerSec);
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("rateLimitBytesPerSec", std::max<qint64>(0, bytesPerSec));
+    cfg.endGroup();
+}
+
+bool LauncherCore::setBandwidthSchedule(const QString& schedule) {
+    if (!m_bandwidth.setSchedule(schedule)) return false;
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("rateSchedule", QString::fromStdString(m_bandwidth.status().schedule));
+    cfg.endGroup();
+    return true;
+}
+
+BandwidthStatus LauncherCore::getBandwidthStatus() {
+    return m_bandwidth.status();
+}
+
+void LauncherCore::setMemoryBudget(qint64 bytes) {
+    m_memory.setLimit(bytes);
+    QSettings cfg(QString::fromStdString(workDir) + "/download.ini", QSettings::IniFormat);
+    cfg.beginGroup("download");
+    cfg.setValue("memoryBudgetBytes", std::max<qint64>(0, bytes));
+    cfg.endGroup();
+}
+
+MemoryStatus LauncherCore::getMemoryStatus() const {
+    return m_memory.status();
+}
+
+std::vector<WarmHost> LauncherCore::getWarmupStatus() const {
+    return m_warmup.status();
+}
+
+qint64 LauncherCore::transferCost(const DownloadTask& t) const {
+    const qint64 threshold = m_segmentThreshold.load();
+    const bool segmented = threshold > 0 && t.size >= threshold;
+    return MemoryBudget::costOf(t.size, segmented ? m_segmentCount.load() : 1);
+}
+
 // ════════════════════════════════════════════════════════════════════════════
 // Network
 // ════════════════════════════════════════════════════════════════════════════
 
-QByteArray LauncherCore::httpGet(const std::string& url, bool* success,
-                                 QNetworkAccessManager* nam) {
-    if (success) *success = false;
-    QNetworkAccessManager* mgr = nam ? nam : networkManager;
-    if (!mgr) return {};
+// Upper bound on what a single reply may buffer before we drain it to disk.
+// Keeps per-transfer memory flat no matter how large the file is.
+static constexpr qint64 STREAM_CHUNK_BYTES = 256 * 1024;
 
+QNetworkRequest LauncherCore::buildRequest(const std::string& url) const {
     QNetworkRequest req(QUrl(QString::fromStdString(url)));
 
-    // ── Force HTTP/1.1 ────────────────────────────────────────────────────
+    // ── HTTP/2 only where it has proven reliable ──────────────────────────
     // Qt enables HTTP/2 by default. BMCLAPI and Mojang CDN both have HTTP/2
     // implementations that cause Qt to emit:
     //   "qt.network.http2: stream N error: Internal server error"
     // followed by a hard stream RST. The resulting QNetworkReply error text
     // is "Internal server error" which is misleading (it is a protocol-level
-    // RST, not an HTTP 500). Forcing HTTP/1.1 eliminates this entirely.
-    req.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+    // RST, not an HTTP 500). HTTP/1.1 stays the default; Http2Policy opts
+    // hosts in (http2=auto) and pins them back after repeated RSTs.
+    req.setAttribute(QNetworkRequest::Http2AllowedAttribute,
+                     m_http2.allowed(req.url().host().toLower()));
 
     // ── SSL ───────────────────────────────────────────────────────────────
     QSslConfiguration ssl = req.sslConfiguration();
@@ -713,8 +982,81 @@ QByteArray LauncherCore::httpGet(const std::string& url, bool* success,
                      QNetworkRequest::NoLessSafeRedirectPolicy);
     req.setHeader(QNetworkRequest::UserAgentHeader,
                   "PCL2-Qt-Launcher/1.0 Mozilla/5.0");
+    return req;
+}
+
+// One QNetworkAccessManager per download worker thread. QNAM keeps its
+// keep-alive connection cache and TLS session cache per instance, so reusing
+// the same instance for every task a worker picks up means only the first
+// request to each host pays for TCP + TLS. QThreadStorage deletes the
+// manager on the owning thread when the pool retires it.
+static QNetworkAccessManager* workerSession() {
+    static QThreadStorage<QNetworkAccessManager*> sessions;
+    if (!sessions.hasLocalData())
+        sessions.setLocalData(new QNetworkAccessManager);
+    return sessions.localData();
+}
+
+void LauncherCore::trackConnection(QNetworkReply* reply) {
+    m_netStats.requests.fetch_add(1, std::memory_order_relaxed);
+    // socketStartedConnecting only fires when no idle keep-alive socket was
+    // available; requestSent marks the end of connect + TLS for that socket.
+    auto connecting = std::make_shared<QElapsedTimer>();
+    connect(reply, &QNetworkReply::socketStartedConnecting, reply, [this, connecting]() {
+        m_netStats.newConnections.fetch_add(1, std::memory_order_relaxed);
+        connecting->start();
+    });
+    connect(reply, &QNetworkReply::requestSent, reply, [this, connecting]() {
+        if (!connecting->isValid()) return;
+        m_netStats.handshakeMs.fetch_add(connecting->elapsed(), std::memory_order_relaxed);
+        connecting->invalidate();
+    });
+    // Every request passes through here, so this is where HTTP/2 stream
+    // failures are attributed to their host.
+    connect(reply, &QNetworkReply::finished, reply, [this, reply]() {
+        const QString host = reply->url().host().toLower();
+        if (m_http2.record(host, reply))
+            emit launchLog(QString("[HTTP/2] Stream errors from %1, using HTTP/1.1 for it from now on")
+                           .arg(host));
+    });
+}
+
+void LauncherCore::reportConnectionReuse(qint64 requestsBefore, qint64 connsBefore,
+                                         qint64 handshakeMsBefore) {
+    const qint64 requests = m_netStats.requests.load() - requestsBefore;
+    const qint64 conns    = m_netStats.newConnections.load() - connsBefore;
+    const qint64 hsMs     = m_netStats.handshakeMs.load() - handshakeMsBefore;
+    if (requests <= 0 || conns <= 0) return;
+
+    // Every request that found a warm socket skipped one average handshake.
+    const qint64 avgMs   = hsMs / conns;
+    const qint64 reused  = std::max<qint64>(0, requests - conns);
+    const qint64 savedMs = reused * avgMs;
+    emit launchLog(QString("[Net] %1 request(s) over %2 connection(s), avg connect+TLS "
+                           "%3 ms; keep-alive avoided ~%4 s of handshakes")
+                   .arg(requests).arg(conns).arg(avgMs)
+                   .arg(savedMs / 1000.0, 0, 'f', 1));
+}
+
+QByteArray LauncherCore::httpGet(const std::string& url, bool* success,
+                                 QNetworkAccessManager* nam, bool cached) {
+    if (success) *success = false;
+    QNetworkAccessManager* mgr = nam ? nam : networkManager;
+    if (!mgr) return {};
+
+    // Accept-Encoding is deliberately left to QNetworkAccessManager: it
+    // offers gzip/deflate on its own and inflates transparently, which an
+    // explicit header would switch off.
+    const QString qurl = QString::fromStdString(url);
+    QNetworkRequest req = buildRequest(url);
+    HttpCache::Entry entry;
+    if (cached) {
+        entry = m_httpCache.load(qurl);
+        HttpCache::addValidators(entry, req);
+    }
 
     QNetworkReply* reply = mgr->get(req);
+    trackConnection(reply);
     QEventLoop loop;
     QTimer timer;
     timer.setSingleShot(true);
@@ -723,18 +1065,26 @@ QByteArray LauncherCore::httpGet(const std::string& url, bool* success,
         loop.quit();
     });
     // Reset inactivity timer on every received chunk
+    const int stallMs = m_retry.stallTimeoutMs;
     connect(reply, &QNetworkReply::downloadProgress, &timer,
-            [&](qint64, qint64) { timer.start(30000); });
+            [&](qint64, qint64) { timer.start(stallMs); });
     connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    timer.start(30000);
+    timer.start(stallMs);
     loop.exec();
     if (timer.isActive()) timer.stop();
 
     QByteArray data;
-    if (reply->error() == QNetworkReply::NoError) {
-        int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (entry.valid && status == 304) {
+        // Unchanged since we cached it: no body crossed the wire.
+        m_httpCache.touch(qurl);
+        data = entry.body;
+        if (success) *success = true;
+    } else if (reply->error() == QNetworkReply::NoError) {
+        int code = status;
         if (code >= 200 && code < 300) {
             data = reply->readAll();
+            if (cached) m_httpCache.store(qurl, data, reply);
             if (success) *success = true;
         } else {
             // Use Qt signal for logging to avoid Windows code-page mojibake
@@ -757,33 +1107,388 @@ QByteArray LauncherCore::httpGet(const std::string& url, bool* success,
     return data;
 }
 
+// ── .part resume bookkeeping ─────────────────────────────────────────────────
+// The sidecar records what the partial body *is* (expected SHA1 + size) and
+// where it came from (mirror URL + ETag / Last-Modified). With a known SHA1
+// the bytes are mirror-independent, so any mirror may continue them and the
+// final hash decides; without one we only resume against the same URL with
+// an If-Range validator.
+
+LauncherCore::PartialDownload
+LauncherCore::loadPartial(const std::string& tmpPath, int size, const std::string& sha1) {
+    PartialDownload part;
+    part.sha1 = sha1;
+    part.size = size;
+
+    std::error_code ec;
+    const qint64 onDisk = fs::exists(tmpPath, ec)
+                        ? static_cast<qint64>(fs::file_size(tmpPath, ec)) : 0;
+    if (ec || onDisk <= 0) return part;
+
+    QFile f(QString::fromStdString(tmpPath + ".json"));
+    if (!f.open(QIODevice::ReadOnly)) { removePartial(tmpPath); return part; }
+    QJsonObject meta = QJsonDocument::fromJson(f.readAll()).object();
+    f.close();
+
+    // A part for a different revision of the file is useless.
+    if (meta["sha1"].toString().toStdString() != sha1 || meta["size"].toInt(-1) != size ||
+        (size > 0 && onDisk > size)) {
+        removePartial(tmpPath);
+        return part;
+    }
+    part.offset       = onDisk;
+    part.etag         = meta["etag"].toString().toUtf8();
+    part.lastModified = meta["lastModified"].toString().toUtf8();
+    part.source       = meta["source"].toString();
+    if (sha1.empty() && part.etag.isEmpty() && part.lastModified.isEmpty()) {
+        removePartial(tmpPath);   // Nothing to prove the bytes are still current
+        part.offset = 0;
+    }
+    return part;
+}
+
+void LauncherCore::savePartial(const std::string& tmpPath, const PartialDownload& part) {
+    QJsonObject meta;
+    meta["sha1"]         = QString::fromStdString(part.sha1);
+    meta["size"]         = part.size;
+    meta["etag"]         = QString::fromUtf8(part.etag);
+    meta["lastModified"] = QString::fromUtf8(part.lastModified);
+    meta["source"]       = part.source;
+    QFile f(QString::fromStdString(tmpPath + ".json"));
+    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        f.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+}
+
+void LauncherCore::removePartial(const std::string& tmpPath) {
+    std::error_code ec;
+    fs::remove(tmpPath, ec);
+    fs::remove(tmpPath + ".json", ec);
+}
+
+bool LauncherCore::httpDownloadToFile(const std::string& url,
+                                      const std::string& tmpPath,
+                                      int expectedSize,
+                                      std::string* sha1Out,
+                                      QNetworkAccessManager* nam,
+                                      PartialDownload* resume,
+                                      MirrorHealth::Sample* sampleOut) {
+    QNetworkAccessManager* mgr = nam ? nam : networkManager;
+    if (!mgr) return false;
+
+    const QString qurl = QString::fromStdString(url);
+    DownloadSink sink(tmpPath, expectedSize, resume, &m_bandwidth);
+    QNetworkRequest req = buildRequest(url);
+    if (!sink.open(qurl, req)) {
+        emit launchLog(QString("[IO] Cannot open %1 for writing")
+                       .arg(QString::fromStdString(tmpPath)));
+        return false;
+    }
+
+    QNetworkReply* reply = mgr->get(req);
+    trackConnection(reply);
+    // Back-pressure: Qt stops reading the socket once this much is buffered,
+    // so a slow disk can never make the reply grow without bound.
+    reply->setReadBufferSize(STREAM_CHUNK_BYTES);
+
+    QEventLoop loop;
+    QTimer timer;
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, &loop, [&]() {
+        if (reply->isRunning()) reply->abort();
+        loop.quit();
+    });
+    // While the bandwidth limiter holds bytes back the read buffer stays full
+    // and no readyRead arrives, so `throttle` re-drains on the limiter's clock.
+    QTimer throttle;
+    throttle.setSingleShot(true);
+    auto pull = [&]() {
+        timer.start(m_retry.stallTimeoutMs);
+        sink.drain(reply);
+        if (sink.backlogged(reply)) throttle.start(static_cast<int>(m_bandwidth.waitMs()));
+    };
+    connect(&throttle, &QTimer::timeout, &loop, pull);
+    connect(reply, &QNetworkReply::readyRead, &loop, [&]() {
+        if (!throttle.isActive()) pull();
+    });
+    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    // Whole-transfer deadline scaled to the expected size, so a mirror that
+    // trickles just fast enough to dodge the stall timer is still dropped.
+    QTimer deadline;
+    deadline.setSingleShot(true);
+    connect(&deadline, &QTimer::timeout, &loop, [&]() { if (reply->isRunning()) reply->abort(); });
+    const qint64 deadlineMs = m_bandwidth.active() ? 0 : m_retry.deadlineMs(expectedSize);
+    if (deadlineMs > 0) deadline.start(static_cast<int>(std::min<qint64>(deadlineMs, INT_MAX)));
+    timer.start(m_retry.stallTimeoutMs);
+    loop.exec();
+    if (timer.isActive()) timer.stop();
+    throttle.stop();
+    deadline.stop();
+
+    const DownloadSink::Result r = sink.finish(reply);
+    const QString msg = sink.errorText(r, qurl);
+    if (!msg.isEmpty()) emit launchLog(msg);
+    reply->deleteLater();
+
+    if (sampleOut) *sampleOut = sink.sample(r == DownloadSink::Result::Ok);
+    if (r == DownloadSink::Result::Ok && sha1Out) *sha1Out = sink.sha1();
+    return r == DownloadSink::Result::Ok;
+}
+
+// ── Segmented download ───────────────────────────────────────────────────────
+// One big file (client jar, JDK `modules`) otherwise crawls over a single
+// connection at the end of a batch. Above the threshold it is split into
+// byte ranges, each fetched on its own worker from a different mirror and
+// written in place into a preallocated <file>.seg; SHA1 is then computed
+// over the stitched result before the rename.
+
+bool LauncherCore::httpFetchRange(const std::string& url, const std::string& tmpPath,
+                                  qint64 begin, qint64 end,
+                                  QNetworkAccessManager* nam,
+                                  MirrorHealth::Sample* sampleOut) {
+    QFile out(QString::fromStdString(tmpPath));
+    if (!out.open(QIODevice::ReadWrite) || !out.seek(begin)) return false;
+
+    QNetworkRequest req = buildRequest(url);
+    req.setRawHeader("Range", "bytes=" + QByteArray::number(begin) + "-" +
+                              QByteArray::number(end));
+    QNetworkReply* reply = nam->get(req);
+    trackConnection(reply);
+    reply->setReadBufferSize(STREAM_CHUNK_BYTES);
+
+    const qint64 want = end - begin + 1;
+    qint64 received   = 0;
+    qint64 ttfbMs     = -1;
+    bool   failed     = false;
+    bool   checked    = false;
+    QElapsedTimer clock;
+    clock.start();
+
+    // `throttled` = go through the bandwidth limiter; the tail after
+    // finished() is already buffered and is charged instead.
+    auto drain = [&](bool throttled) {
+        if (!checked) {
+            checked = true;
+            ttfbMs  = clock.elapsed();
+            // A 200 means the mirror ignored Range – its body would land at
+            // the wrong offset, so give up on this segment/mirror.
+            const int code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QByteArray expect = "bytes " + QByteArray::number(begin) + "-" +
+                                      QByteArray::number(end) + "/";
+            if (code != 206 || !reply->rawHeader("Content-Range").startsWith(expect)) {
+                failed = true;
+                reply->abort();
+                return;
+            }
+        }
+        while (reply->bytesAvailable() > 0 && !failed) {
+            qint64 n = std::min(STREAM_CHUNK_BYTES, reply->bytesAvailable());
+            if (throttled) {
+                n = m_bandwidth.take(n);
+                if (n == 0) return;
+            } else {
+                m_bandwidth.charge(n);
+            }
+            QByteArray chunk = reply->read(n);
+            received += chunk.size();
+            if (received > want || out.write(chunk) != chunk.size()) {
+                failed = true;
+                reply->abort();
+                return;
+            }
+        }
+    };
+
+    QEventLoop loop;
+    QTimer timer;
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, &loop, [&]() {
+        if (reply->isRunning()) reply->abort();
+        loop.quit();
+    });
+    QTimer throttle;
+    throttle.setSingleShot(true);
+    auto pull = [&]() {
+        timer.start(m_retry.stallTimeoutMs);
+        drain(true);
+        if (!failed && reply->bytesAvailable() > 0)
+            throttle.start(static_cast<int>(m_bandwidth.waitMs()));
+    };
+    connect(&throttle, &QTimer::timeout, &loop, pull);
+    connect(reply, &QNetworkReply::readyRead, &loop, [&]() {
+        if (!throttle.isActive()) pull();
+    });
+    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    QTimer deadline;
+    deadline.setSingleShot(true);
+    connect(&deadline, &QTimer::timeout, &loop, [&]() { if (reply->isRunning()) reply->abort(); });
+    const qint64 deadlineMs = m_bandwidth.active() ? 0 : m_retry.deadlineMs(want);
+    if (deadlineMs > 0) deadline.start(static_cast<int>(std::min<qint64>(deadlineMs, INT_MAX)));
+    timer.start(m_retry.stallTimeoutMs);
+    loop.exec();
+    if (timer.isActive()) timer.stop();
+    throttle.stop();
+    deadline.stop();
+
+    const bool netOk = reply->error() == QNetworkReply::NoError;
+    if (netOk) drain(false);
+    const bool ok = netOk && !failed && received == want;
+    if (sampleOut) {
+        sampleOut->ok        = ok;
+        sampleOut->ttfbMs    = ttfbMs;
+        sampleOut->bytes     = received;
+        sampleOut->elapsedMs = clock.elapsed();
+        sampleOut->httpCode  = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        sampleOut->stalled   = !failed && reply->error() == QNetworkReply::OperationCanceledError;
+        sampleOut->reset     = reply->error() == QNetworkReply::RemoteHostClosedError ||
+                               reply->error() == QNetworkReply::ConnectionRefusedError;
+    }
+    reply->deleteLater();
+    return ok;
+}
+
+bool LauncherCore::downloadSegmented(const std::string& originalUrl,
+                                     const QStringList& urls, const std::string& path,
+                                     int size, const std::string& sha1) {
+    const std::string segPath = path + ".seg";
+    {
+        // Preallocate so every segment can seek straight to its offset; the
+        // reservation keeps resize() from leaving a sparse file behind.
+        QFile f(QString::fromStdString(segPath));
+        if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) DiskSync::reserve(f, size);
+        if (!f.isOpen() || !f.resize(size)) {
+            std::error_code ec;
+            fs::remove(segPath, ec);
+            return false;
+        }
+    }
+
+    struct Segment { qint64 begin; qint64 end; int mirror; };
+    const int count = std::max(1, std::min(m_segmentCount.load(),
+                                           static_cast<int>(size / (1024 * 1024))));
+    const qint64 step = (static_cast<qint64>(size) + count - 1) / count;
+    std::vector<Segment> segments;
+    for (int i = 0; i < count; ++i) {
+        const qint64 b = i * step;
+        if (b >= size) break;
+        segments.push_back({ b, std::min<qint64>(size, b + step) - 1, i });
+    }
+
+    // Segment i starts on mirror i (mod n) so the load is spread, and walks
+    // the remaining mirrors in order if that one fails.
+    std::atomic<bool> allOk{true};
+    QtConcurrent::blockingMap(&m_segmentPool, segments, [&](const Segment& s) {
+        for (int k = 0; k < urls.size() && allOk; ++k) {
+            const QString& u = urls[(s.mirror + k) % urls.size()];
+            const QString host = HostConcurrency::hostOf(u);
+            if (!m_breakers.allow(host)) continue;
+            MirrorHealth::Sample sample;
+            m_hostLimits.acquire(host);
+            const bool ok = httpFetchRange(u.toStdString(), segPath, s.begin, s.end,
+                                           workerSession(), &sample);
+            m_hostLimits.release(host, sample);
+            recordHostOutcome(host, sample);
+            m_mirrorHealth.record(QString::fromStdString(originalUrl), u, sample);
+            if (ok) return;
+        }
+        allOk = false;
+    });
+
+    std::error_code ec;
+    if (allOk && (sha1.empty() || calculateFileSha1(segPath) == sha1)) {
+        if (commitVerified(segPath, path, sha1, ec)) return true;
+    }
+    emit launchLog(QString("[Segmented] Falling back to a single stream: %1")
+                   .arg(QString::fromStdString(path)));
+    fs::remove(segPath, ec);
+    return false;
+}
+
 bool LauncherCore::downloadFile(const std::string& url, const std::string& path,
                                 int size, const std::string& sha1,
                                 QNetworkAccessManager* nam) {
     fs::create_directories(fs::path(path).parent_path());
     if (validateFile(path, size, sha1)) {
         // Already valid on disk, nothing to do
+        removePartial(path + ".part");
         return true;
     }
 
-    QStringList urls = buildMirrorUrls(QString::fromStdString(url));
-    for (int i = 0; i < urls.size(); ++i) {
-        bool ok = false;
-        QByteArray data = httpGet(urls[i].toStdString(), &ok, nam);
-        if (!ok) {
-            // This mirror failed; try next one
-            continue;
+    // The body is streamed into a sibling .part file and only renamed over
+    // `path` once size and SHA1 (computed while receiving) both match, so the
+    // final path never holds a truncated or corrupt file. Interrupted parts
+    // are kept and continued with Range requests by the next mirror or the
+    // next launch.
+    const std::string tmpPath = path + ".part";
+    PartialDownload part = loadPartial(tmpPath, size, sha1);
+    if (part.offset > 0)
+        emit launchLog(QString("[Resume] %1 bytes already on disk: %2")
+                       .arg(part.offset).arg(QString::fromStdString(path)));
+    std::error_code ec;
+
+    if (placeFromLocal(path, size, sha1)) return true;
+
+    QStringList urls = candidateUrls(url, path);
+
+    // Large files with no resumable part go multi-connection first; any
+    // failure there falls through to the regular single-stream loop.
+    const qint64 threshold = m_segmentThreshold.load();
+    if (threshold > 0 && size >= threshold && part.offset == 0 &&
+        downloadSegmented(url, urls, path, size, sha1))
+        return true;
+
+    // Each round walks every mirror whose circuit breaker lets it through;
+    // between rounds the worker backs off (exponential, full jitter) and the
+    // mirror order is re-ranked with whatever was learned in the meantime.
+    for (int round = 0; round < m_retry.rounds; ++round) {
+        if (round > 0) {
+            const int delay = m_retry.backoffMs(round - 1);
+            emit launchLog(QString("[Retry] Round %1/%2 in %3 ms: %4")
+                           .arg(round + 1).arg(m_retry.rounds).arg(delay)
+                           .arg(QString::fromStdString(path)));
+            QThread::msleep(static_cast<unsigned long>(delay));
+            urls = candidateUrls(url, path);
+        }
+        for (int i = 0; i < urls.size(); ++i) {
+            std::string gotSha1;
+            MirrorHealth::Sample sample;
+            const QString host = HostConcurrency::hostOf(urls[i]);
+            if (!m_breakers.allow(host)) continue;
+            m_hostLimits.acquire(host);
+            const bool fetched = httpDownloadToFile(urls[i].toStdString(), tmpPath, size,
+                                                    &gotSha1, nam, &part, &sample);
+            // A body that fails its hash counts against the mirror like an error.
+            sample.ok = fetched && (sha1.empty() || gotSha1 == sha1);
+            m_hostLimits.release(host, sample);
+            recordHostOutcome(host, sample);
+            m_mirrorHealth.record(QString::fromStdString(url), urls[i], sample);
+            if (!fetched) {
+                // This mirror failed; keep whatever it delivered and let the
+                // next one continue from there.
+                if (part.discard || part.offset == 0) {
+                    removePartial(tmpPath);
+                    part = loadPartial(tmpPath, size, sha1);
+                }
+                continue;
+            }
+            if (sha1.empty() || gotSha1 == sha1) {
+                if (commitVerified(tmpPath, path, sha1, ec)) { removePartial(tmpPath); return true; }
+                emit launchLog(QString("[IO] Rename failed (%1): %2")
+                               .arg(QString::fromStdString(ec.message()))
+                               .arg(QString::fromStdString(path)));
+                removePartial(tmpPath);
+                return false;
+            }
+            // Validation failed – this mirror returned corrupt data (or a resumed
+            // prefix did not belong to it). Remove the bad file and fall through
+            // to the next mirror URL, starting from zero.
+            emit const_cast<LauncherCore*>(this)->launchLog(
+                QString("[Corrupt] Mirror %1 returned invalid data, trying next mirror: %2")
+                .arg(urls[i])
+                .arg(QString::fromStdString(path)));
+            removePartial(tmpPath);
+            part = loadPartial(tmpPath, size, sha1);
+            continue;  // FIX: was `return false`, now retries remaining mirrors
         }
-        { std::ofstream f(path, std::ios::binary); f.write(data.constData(), data.size()); }
-        if (validateFile(path, size, sha1)) return true;
-        // Validation failed – this mirror returned corrupt/truncated data.
-        // Remove the bad file and fall through to the next mirror URL.
-        emit const_cast<LauncherCore*>(this)->launchLog(
-            QString("[Corrupt] Mirror %1 returned invalid data, trying next mirror: %2")
-            .arg(urls[i])
-            .arg(QString::fromStdString(path)));
-        fs::remove(path);
-        continue;  // FIX: was `return false`, now retries remaining mirrors
     }
     emit const_cast<LauncherCore*>(this)->launchLog(
         QString("[Failed] All mirrors exhausted for: %1")
@@ -796,18 +1501,33 @@ bool LauncherCore::downloadFile(const std::string& url, const std::string& path,
 // ════════════════════════════════════════════════════════════════════════════
 
 std::string LauncherCore::calculateFileSha1(const std::string& filepath) {
-    QFile f(QString::fromStdString(filepath));
-    if (!f.open(QIODevice::ReadOnly)) return {};
-    QCryptographicHash h(QCryptographicHash::Sha1);
-    h.addData(&f);
-    return h.result().toHex().toStdString();
+    // Mapped or readahead-hinted reads depending on size (see Sha1::fileHex).
+    return Sha1::fileHex(QString::fromStdString(filepath));
 }
 
+// Unchanged metadata since the last verification skips the hash (see
+// VerifiedIndex); a fresh hash refreshes or drops the entry.
 bool LauncherCore::validateFile(const std::string& filepath, int size,
                                 const std::string& sha1) {
     if (!fs::exists(filepath)) return false;
     if (size > 0 && static_cast<int>(fs::file_size(filepath)) != size) return false;
-    if (!sha1.empty() && calculateFileSha1(filepath) != sha1) return false;
+    if (sha1.empty() || m_verified.lookup(filepath, size, sha1)) return true;
+    if (calculateFileSha1(filepath) != sha1) {
+        m_verified.forget(filepath);
+        return false;
+    }
+    m_verified.record(filepath, sha1);
+    return true;
+}
+
+bool LauncherCore::commitVerified(const std::string& tmp, const std::string& dst,
+                                  const std::string& sha1, std::error_code& ec) {
+    m_verified.forget(tmp);
+    if (!m_diskSync.commit(tmp, dst, ec)) {
+        m_verified.forget(dst);
+        return false;
+    }
+    m_verified.record(dst, sha1);
     return true;
 }
 
@@ -826,41 +1546,251 @@ bool LauncherCore::extractNative(const std::string& archivePath,
 // Batch download
 // ════════════════════════════════════════════════════════════════════════════
 
-bool LauncherCore::batchDownload(const std::vector<DownloadTask>& tasks,
-                                 int maxThreads,
-                                 std::function<void(int, int)> progressCallback) {
-    if (tasks.empty()) return true;
+bool LauncherCore::scheduledBefore(const DownloadTask& a, const DownloadTask& b) {
+    if (a.priority != b.priority) return a.priority < b.priority;
+    return a.size > b.size;   // -1 (unknown) sorts after every known size
+}
+
+bool LauncherCore::claimTransfer(const std::string& path, SettledFn onSettled) {
+    QMutexLocker lk(&m_inFlightLock);
+    auto it = m_inFlight.find(path);
+    if (it != m_inFlight.end()) {
+        it->second.waiters.push_back(std::move(onSettled));
+        return false;
+    }
+    m_inFlight.emplace(path, InFlight{});
+    return true;
+}
+
+void LauncherCore::settleTransfer(const std::string& path, bool ok) {
+    std::vector<SettledFn> waiters;
+    {
+        QMutexLocker lk(&m_inFlightLock);
+        auto it = m_inFlight.find(path);
+        if (it == m_inFlight.end()) return;
+        waiters.swap(it->second.waiters);
+        m_inFlight.erase(it);
+    }
+    for (const SettledFn& fn : waiters) fn(ok);
+}
+
+bool LauncherCore::batchDownload(const std::vector<DownloadTask>& unordered,
+                                 std::function<void(const DownloadProgress&)> progressCallback,
+                                 ProgressMeter* sharedMeter) {
+    if (unordered.empty()) {
+        if (sharedMeter) sharedMeter->addBatch(0, 0);
+        return true;
+    }
+    // Both backends hand out work roughly in vector order, so sort once here:
+    // launch-critical files first, longest job first within each class.
+    std::vector<DownloadTask> tasks = unordered;
+    std::stable_sort(tasks.begin(), tasks.end(), scheduledBefore);
+
+    // Asset indexes map several keys to one hash, i.e. one destination path.
+    // Keep the first (highest-priority) task per path; a duplicate that asks
+    // for extraction passes that on so natives are still unpacked.
+    {
+        std::unordered_map<std::string, size_t> seen;
+        std::vector<DownloadTask> unique;
+        unique.reserve(tasks.size());
+        for (DownloadTask& t : tasks) {
+            auto [it, fresh] = seen.emplace(t.path, unique.size());
+            if (fresh) { unique.push_back(std::move(t)); continue; }
+            DownloadTask& kept = unique[it->second];
+            if (t.extract && !kept.extract) {
+                kept.extract       = true;
+                kept.extractTarget = t.extractTarget;
+            }
+        }
+        if (unique.size() != tasks.size())
+            emit launchLog(QString("[Download] Skipped %1 duplicate task(s)")
+                           .arg(tasks.size() - unique.size()));
+        tasks.swap(unique);
+    }
+
+    std::unique_ptr<ProgressMeter> ownMeter;
+    if (sharedMeter) {
+        sharedMeter->addBatch(static_cast<int>(tasks.size()), knownBytes(tasks));
+    } else {
+        ownMeter = std::make_unique<ProgressMeter>(static_cast<int>(tasks.size()),
+                                                   knownBytes(tasks), &m_bandwidth);
+    }
+    ProgressMeter& meter = sharedMeter ? *sharedMeter : *ownMeter;
+
+    if (m_backend.load() == DownloadBackend::Async)
+        return batchDownloadAsync(tasks, progressCallback, meter);
 
-    QThreadPool pool;
-    pool.setMaxThreadCount(maxThreads);
+    // Shared, long-lived pool: each worker reuses its own session (see
+    // workerSession) for every task, instead of a fresh QNAM per file.
+    // The pool is sized for the largest window HostConcurrency can grant;
+    // the per-host AIMD windows decide how many actually hit the network.
+    m_downloadPool.setMaxThreadCount(m_hostLimits.maximum());
 
+    const int total = static_cast<int>(tasks.size());
     std::atomic<int>  done{0};
     std::atomic<bool> allOk{true};
-    int total = static_cast<int>(tasks.size());
-    QMutex cbMutex;
+    QMutex         waitLock;
+    QWaitCondition allDone;
 
-    QtConcurrent::blockingMap(&pool, tasks, [&](const DownloadTask& t) {
-        QNetworkAccessManager localNam;
-        bool ok = downloadFile(t.url, t.path, t.size, t.sha1, &localNam);
+    const qint64 reqBefore  = m_netStats.requests.load();
+    const qint64 connBefore = m_netStats.newConnections.load();
+    const qint64 hsBefore   = m_netStats.handshakeMs.load();
+
+    // Extraction, accounting and the wake-up. Everything after the fetch
+    // happens before `done` reaches total, so awaitBatch keeps this frame
+    // alive for the continuations below.
+    auto finish = [&](const DownloadTask& t, bool ok, qint64 present) {
         if (ok && t.extract && !t.extractTarget.empty())
             ok = extractNative(t.path, t.extractTarget);
         if (!ok) allOk = false;
-        int n = ++done;
-        if (progressCallback) {
-            // Report every 5 files OR on the very last file so progress always
-            // reaches 100%. Do NOT hold the mutex while calling the callback –
-            // the callback may itself emit Qt signals which acquire their own
-            // locks (deadlock risk). Use try-lock: if we lose the race, the
-            // next iteration will report instead.
-            bool isLast = (n == total);
-            bool periodic = (n % 5 == 0);
-            if (isLast || periodic) {
-                QMutexLocker lk(&cbMutex);
-                progressCallback(n, total);
-            }
+        meter.fileDone(present, t.size);
+        QMutexLocker lk(&waitLock);
+        if (++done == total) allDone.wakeAll();
+    };
+
+    QFuture<void> work = QtConcurrent::map(&m_downloadPool, tasks, [&](const DownloadTask& t) {
+        const bool owner = claimTransfer(t.path, [this, t, &finish](bool ok) {
+            // Runs on the owner's thread; unpacking is handed to the pool.
+            if (ok && t.extract && !t.extractTarget.empty())
+                m_downloadPool.start([t, ok, &finish]() { finish(t, ok, 0); });
+            else
+                finish(t, ok, 0);
+        });
+        if (!owner) return;
+
+        bool   ok;
+        qint64 present = 0;
+        // Checked here rather than only inside downloadFile so a file
+        // that is already on disk counts as progress without transfer.
+        if (validateFile(t.path, t.size, t.sha1)) {
+            removePartial(t.path + ".part");
+            ok      = true;
+            present = std::max(t.size, 0);
+        } else {
+            // Waits here, holding no slot, while the memory ceiling is reached.
+            MemoryBudget::Lease mem = m_memory.acquire(transferCost(t));
+            ok = downloadFile(t.url, t.path, t.size, t.sha1, workerSession());
         }
+        settleTransfer(t.path, ok);
+        finish(t, ok, present);
     });
 
+    awaitBatch(meter, waitLock, allDone, done, total, progressCallback);
+    work.waitForFinished();
+
+    // One durability point for the whole batch (see DiskSync).
+    m_diskSync.flush();
+    m_verified.save();
+    reportConnectionReuse(reqBefore, connBefore, hsBefore);
+    return allOk.load();
+}
+
+qint64 LauncherCore::knownBytes(const std::vector<DownloadTask>& tasks) {
+    qint64 sum = 0;
+    for (const DownloadTask& t : tasks) sum += std::max(t.size, 0);
+    return sum;
+}
+
+// Progress is reported from here, on the thread that called batchDownload,
+// so callbacks never run on the engine thread (and, via the meter's lock,
+// never concurrently). The timed wait makes a slow single file (the client
+// jar) report at the same rate as a stream of small assets.
+void LauncherCore::awaitBatch(ProgressMeter& meter, QMutex& waitLock, QWaitCondition& allDone,
+                              const std::atomic<int>& done, int total,
+                              const std::function<void(const DownloadProgress&)>& progressCallback) {
+    for (;;) {
+        meter.report(progressCallback);
+        QMutexLocker lk(&waitLock);
+        if (done.load() >= total) break;
+        allDone.wait(&waitLock, static_cast<unsigned long>(ProgressMeter::REPORT_INTERVAL_MS));
+    }
+    meter.report(progressCallback);
+}
+
+// ── Async backend ─────────────────────────────────────────────────────────────
+// m_verifyPool workers only do the disk-bound part (validateFile, local
+// mirrors); every file that needs fetching is handed on the moment it is
+// found – to DownloadEngine, which keeps up to maxInFlight transfers running
+// on one thread, gated per host by HostConcurrency, or, above the segment
+// threshold, to an m_downloadPool worker on the blocking path, which splits
+// it into parallel ranges. A file another batch is already fetching is
+// finished by a continuation when that transfer settles, so no thread is
+// ever parked on a claim.
+bool LauncherCore::batchDownloadAsync(const std::vector<DownloadTask>& tasks,
+                                      std::function<void(const DownloadProgress&)> progressCallback,
+                                      ProgressMeter& meter) {
+    m_downloadPool.setMaxThreadCount(std::max(4, QThread::idealThreadCount()));
+
+    const int total = static_cast<int>(tasks.size());
+    std::atomic<int>  done{0};
+    std::atomic<bool> allOk{true};
+    QMutex         waitLock;
+    QWaitCondition allDone;
+
+    const qint64 reqBefore  = m_netStats.requests.load();
+    const qint64 connBefore = m_netStats.newConnections.load();
+    const qint64 hsBefore   = m_netStats.handshakeMs.load();
+
+    // Runs on a pool worker or the engine thread. Everything happens under
+    // waitLock so the waiting caller cannot unwind this frame while the last
+    // completion is still reporting.
+    auto finishOne = [&](bool ok, qint64 present, int size) {
+        QMutexLocker lk(&waitLock);
+        if (!ok) allOk = false;
+        meter.fileDone(present, size);
+        if (++done == total) allDone.wakeAll();
+    };
+
+    const qint64 threshold = m_segmentThreshold.load();
+    // finishOne is reached for every task before awaitBatch returns, so the
+    // download-pool jobs below may hold references into this frame.
+    QFuture<void> verify = QtConcurrent::map(&m_verifyPool, tasks, [&](const DownloadTask& t) {
+        if (validateFile(t.path, t.size, t.sha1)) {
+            removePartial(t.path + ".part");
+            finishOne(true, std::max(t.size, 0), t.size);
+            return;
+        }
+        const int size = t.size;
+        const bool owner = claimTransfer(t.path, [size, &finishOne](bool ok) {
+            // Another batch fetched this file; finishOne never blocks.
+            finishOne(ok, 0, size);
+        });
+        if (!owner) {
+            return;
+        } else if (placeFromLocal(t.path, t.size, t.sha1)) {
+            // Disk-bound like verification, so it stays on this worker.
+            settleTransfer(t.path, true);
+            finishOne(true, std::max(t.size, 0), t.size);
+        } else if (threshold > 0 && t.size >= threshold) {
+            m_downloadPool.start([this, t, &finishOne]() {
+                MemoryBudget::Lease mem = m_memory.acquire(transferCost(t));
+                const bool ok = downloadFile(t.url, t.path, t.size, t.sha1, workerSession());
+                settleTransfer(t.path, ok);
+                finishOne(ok, 0, t.size);
+            });
+        } else {
+            const std::string path = t.path;
+            const int         size = t.size;
+            m_engine->submit(t, [this, path, size, &finishOne](bool ok) {
+                settleTransfer(path, ok);
+                finishOne(ok, 0, size);
+            });
+        }
+    });
+
+    awaitBatch(meter, waitLock, allDone, done, total, progressCallback);
+    verify.waitForFinished();
+
+    // Natives are unpacked after the fact so the engine thread never blocks
+    // on an external tar process.
+    for (const DownloadTask& t : tasks) {
+        if (t.extract && !t.extractTarget.empty() && !extractNative(t.path, t.extractTarget))
+            allOk = false;
+    }
+
+    m_diskSync.flush();
+    m_verified.save();
+    reportConnectionReuse(reqBefore, connBefore, hsBefore);
     return allOk.load();
 }
 
@@ -877,7 +1807,7 @@ std::vector<MinecraftVersion> LauncherCore::getVersionList() {
         "https://launchermeta.mojang.com/mc/game/version_manifest.json",
     };
     for (const QString& u : urls) {
-        QByteArray resp = httpGet(u.toStdString());
+        QByteArray resp = httpGet(u.toStdString(), nullptr, nullptr, true);
         if (resp.isEmpty()) continue;
         QJsonDocument doc = QJsonDocument::fromJson(resp);
         if (!doc.isObject()) continue;
@@ -926,7 +1856,11 @@ QJsonObject LauncherCore::getVersionManifest(const std::string& versionId) {
     QByteArray data = httpGet(url);
     if (data.isEmpty()) return {};
     fs::create_directories(fs::path(local).parent_path());
-    { std::ofstream out(local); out << data.toStdString(); }
+    {
+        // Atomic, so an interrupted write never leaves a truncated manifest.
+        QSaveFile out(QString::fromStdString(local));
+        if (out.open(QIODevice::WriteOnly)) { out.write(data); out.commit(); }
+    }
     return QJsonDocument::fromJson(data).object();
 }
 
@@ -1000,6 +1934,7 @@ int LauncherCore::launchGame(const std::string& versionId,
     if (!customCmd.isEmpty() && !stepCustomCommands(ctx))
         emit launchLog("[Warning] Custom command failed (non-fatal).");
     if (!stepLaunch(ctx))            { emit launchLog("[Error] Process launch failed."); return 1; }
+    startDeepCheck(ctx.versionId);
 
     QThread* watcher = QThread::create([this, ctx]() mutable { stepWait(ctx); });
     watcher->start();
@@ -1048,118 +1983,258 @@ bool LauncherCore::stepCheckJava(LaunchContext& ctx) {
 bool LauncherCore::stepFixFiles(LaunchContext& ctx) {
     emit launchLog("[2/8] Verifying game files...");
 
+    std::string cp;
+    libraryTasks(ctx.versionManifest, &cp);
+    cp += (fs::path(workDir) / "versions" / ctx.versionId / (ctx.versionId + ".jar")).string();
+    ctx.classPath = QString::fromStdString(cp);
+
+    const bool fast = m_verifyMode.load() == VerifyMode::Fast;
+    std::vector<DownloadTask> deferred;
+    int logged = -1;
+    const InstallResult r = installVersionFiles(ctx.versionId, ctx.versionManifest,
+        [this, &logged](const DownloadProgress& p) {
+            emit downloadProgress("launch", p.bytesDone, p.bytesTotal, p.bytesPerSec, p.etaMs);
+            // The log only gets a line per 10 %, not every report.
+            if (p.percent() / 10 == logged && !p.finished) return;
+            logged = p.percent() / 10;
+            emit launchLog(QString("  Progress: %1/%2%3")
+                           .arg(p.filesDone).arg(p.filesTotal).arg(transferSuffix(p)));
+        }, fast ? &deferred : nullptr);
+    // Missing assets cost sounds and languages, not the launch.
+    if (!r.assets) emit launchLog("  Some assets could not be downloaded");
+
+    // Files queued by an earlier deep check went through the full check
+    // above; those that pass now are repaired.
+    for (const RepairEntry& e : m_repairs.entries()) {
+        if (validateFile(e.path, e.size, e.sha1)) m_repairs.remove(e.path);
+    }
+    m_repairs.save();
+
+    if (fast) {
+        emit launchLog(QString("  Fast check: %1 file(s) trusted by size, SHA-1 check after launch")
+                       .arg(deferred.size()));
+        QMutexLocker lk(&m_integrityLock);
+        m_deferredChecks = std::move(deferred);
+    }
+    return r.core;
+}
+
+// ── Tiered verification ─────────────────────────────────────────────────────
+// Only presence and size are checked here: one stat per file.
+void LauncherCore::deferPresent(std::vector<DownloadTask>& tasks,
+                                std::vector<DownloadTask>& deferred) const {
+    std::vector<DownloadTask> keep;
+    for (DownloadTask& t : tasks) {
+        std::error_code ec;
+        const std::uintmax_t size = fs::file_size(t.path, ec);
+        const bool present = !ec && (t.size <= 0 || size == static_cast<std::uintmax_t>(t.size));
+        if (present && !t.sha1.empty() && !m_repairs.contains(t.path))
+            deferred.push_back(std::move(t));
+        else
+            keep.push_back(std::move(t));
+    }
+    tasks.swap(keep);
+}
+
+void LauncherCore::startDeepCheck(const std::string& versionId) {
+    std::vector<DownloadTask> tasks;
+    {
+        QMutexLocker lk(&m_integrityLock);
+        if (m_integrity.running) return;   // The running pass re-arms nothing
+        tasks.swap(m_deferredChecks);
+        if (tasks.empty()) return;
+        m_integrity = IntegrityStatus{};
+        m_integrity.running   = true;
+        m_integrity.versionId = versionId;
+        m_integrity.total     = static_cast<int>(tasks.size());
+    }
+    emit launchLog(QString("[Verify] Checking %1 file(s) in the background").arg(tasks.size()));
+
+    // The previous pass has cleared `running`, so its thread is at most
+    // returning; reap it before starting the next.
+    if (m_deepCheck) {
+        m_deepCheck->wait();
+        delete m_deepCheck;
+    }
+    m_deepCheckStop = false;
+
+    // One thread at idle CPU priority (SCHED_IDLE on Linux; every other
+    // QThread priority is a no-op under SCHED_OTHER) and, on Linux, the idle
+    // I/O class, so the game's own loading always wins. Files the
+    // VerifiedIndex already vouches for cost a stat.
+    m_deepCheck = QThread::create([this, tasks = std::move(tasks)]() {
+#if defined(Q_OS_LINUX)
+        // ioprio_set(IOPRIO_WHO_PROCESS, this thread, IOPRIO_CLASS_IDLE)
+        ::syscall(SYS_ioprio_set, 1, 0, 3 << 13);
+#endif
+        int corrupt = 0;
+        for (const DownloadTask& t : tasks) {
+            if (m_deepCheckStop) break;
+            if (!validateFile(t.path, t.size, t.sha1)) {
+                ++corrupt;
+                m_repairs.add({ t.path, t.size, t.sha1 });
+                emit launchLog(QString("[Verify] %1 is missing or corrupt; it will be "
+                                       "repaired before the next launch")
+                               .arg(QString::fromStdString(t.path)));
+            }
+            QMutexLocker lk(&m_integrityLock);
+            ++m_integrity.checked;
+            m_integrity.corrupt = corrupt;
+        }
+        // Keep what was found even when cut short by shutdown.
+        m_repairs.save();
+        m_verified.save();
+        {
+            QMutexLocker lk(&m_integrityLock);
+            m_integrity.running = false;
+        }
+        if (!m_deepCheckStop)
+            emit launchLog(QString("[Verify] Background check done: %1 file(s), %2 corrupt")
+                           .arg(tasks.size()).arg(corrupt));
+    });
+    m_deepCheck->start(QThread::IdlePriority);
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// Version file sets
+// ════════════════════════════════════════════════════════════════════════════
+// Tasks are returned unverified: batchDownload checks every file on disk in
+// its worker pool, in parallel, instead of hashing them one by one here.
+
+std::vector<LauncherCore::DownloadTask>
+LauncherCore::libraryTasks(const QJsonObject& manifest, std::string* classPath) const {
 #ifdef Q_OS_WIN
     const std::string sep = ";";
 #else
     const std::string sep = ":";
 #endif
-    std::string cp;
     std::vector<DownloadTask> tasks;
+    for (const QJsonValue& lv : manifest["libraries"].toArray()) {
+        QJsonObject lib = lv.toObject();
+        if (lib.contains("rules") && !evaluateRules(lib["rules"].toArray())) continue;
 
-    if (ctx.versionManifest.contains("libraries")) {
-        for (const QJsonValue& lv : ctx.versionManifest["libraries"].toArray()) {
-            QJsonObject lib = lv.toObject();
-            if (lib.contains("rules") && !evaluateRules(lib["rules"].toArray())) continue;
-
-            QJsonObject downloads = lib["downloads"].toObject();
-
-            if (downloads.contains("artifact")) {
-                QJsonObject art = downloads["artifact"].toObject();
-                std::string p   = art["path"].toString().toStdString();
-                std::string fp  = (fs::path(workDir) / "libraries" / p).string();
-                std::string url = art["url"].toString().toStdString();
-                int  sz         = art["size"].toInt(-1);
-                std::string sha = art["sha1"].toString().toStdString();
-                if (!validateFile(fp, sz, sha)) tasks.push_back({url, fp, sz, sha});
-                if (!fp.empty()) cp += fp + sep;
-            }
+        QJsonObject downloads = lib["downloads"].toObject();
+
+        if (downloads.contains("artifact")) {
+            QJsonObject art = downloads["artifact"].toObject();
+            std::string p   = art["path"].toString().toStdString();
+            std::string fp  = (fs::path(workDir) / "libraries" / p).string();
+            std::string url = art["url"].toString().toStdString();
+            int  sz         = art["size"].toInt(-1);
+            std::string sha = art["sha1"].toString().toStdString();
+            tasks.push_back({url, fp, sz, sha, false, {}, DownloadPriority::Critical});
+            if (classPath && !fp.empty()) *classPath += fp + sep;
+        }
 
-            if (downloads.contains("classifiers")) {
+        if (downloads.contains("classifiers")) {
 #if defined(Q_OS_WIN)
-                QString key = "natives-windows";
+            QString key = "natives-windows";
 #elif defined(Q_OS_MACOS)
-                QString key = "natives-osx";
+            QString key = "natives-osx";
 #else
-                QString key = "natives-linux";
+            QString key = "natives-linux";
 #endif
-                QJsonObject cls = downloads["classifiers"].toObject();
-                QString arch = (QSysInfo::currentCpuArchitecture() == "x86_64") ? "64" : "32";
-                if (!cls.contains(key)) key = key + "-" + arch;
-                if (cls.contains(key)) {
-                    QJsonObject nat = cls[key].toObject();
-                    std::string p   = nat["path"].toString().toStdString();
-                    std::string fp  = (fs::path(workDir) / "libraries" / p).string();
-                    std::string url = nat["url"].toString().toStdString();
-                    int  sz         = nat["size"].toInt(-1);
-                    std::string sha = nat["sha1"].toString().toStdString();
-                    if (!validateFile(fp, sz, sha)) tasks.push_back({url, fp, sz, sha});
-                }
+            QJsonObject cls = downloads["classifiers"].toObject();
+            QString arch = (QSysInfo::currentCpuArchitecture() == "x86_64") ? "64" : "32";
+            if (!cls.contains(key)) key = key + "-" + arch;
+            if (cls.contains(key)) {
+                QJsonObject nat = cls[key].toObject();
+                std::string p   = nat["path"].toString().toStdString();
+                std::string fp  = (fs::path(workDir) / "libraries" / p).string();
+                std::string url = nat["url"].toString().toStdString();
+                int  sz         = nat["size"].toInt(-1);
+                std::string sha = nat["sha1"].toString().toStdString();
+                tasks.push_back({url, fp, sz, sha, false, {}, DownloadPriority::Critical});
             }
         }
     }
+    return tasks;
+}
 
-    // Client JAR
-    std::string clientJar = (fs::path(workDir) / "versions" / ctx.versionId
-                             / (ctx.versionId + ".jar")).string();
-    if (ctx.versionManifest.contains("downloads")) {
-        QJsonObject cl = ctx.versionManifest["downloads"].toObject()["client"].toObject();
-        std::string url = cl["url"].toString().toStdString();
-        int  sz  = cl["size"].toInt(-1);
-        std::string sha = cl["sha1"].toString().toStdString();
-        if (!validateFile(clientJar, sz, sha)) tasks.push_back({url, clientJar, sz, sha});
-    }
-    cp += clientJar;
-    ctx.classPath = QString::fromStdString(cp);
+bool LauncherCore::clientJarTask(const std::string& versionId, const QJsonObject& manifest,
+                                 DownloadTask& out) const {
+    if (!manifest.contains("downloads")) return false;
+    QJsonObject cl = manifest["downloads"].toObject()["client"].toObject();
+    out = {cl["url"].toString().toStdString(),
+           (fs::path(workDir) / "versions" / versionId / (versionId + ".jar")).string(),
+           cl["size"].toInt(-1), cl["sha1"].toString().toStdString(),
+           false, {}, DownloadPriority::Critical};
+    return !out.url.empty();
+}
 
-    // Asset index
-    std::string assetId = ctx.versionManifest.contains("assets")
-                        ? ctx.versionManifest["assets"].toString().toStdString() : "legacy";
-    std::string idxPath = (fs::path(workDir) / "assets" / "indexes"
-                           / (assetId + ".json")).string();
-    if (ctx.versionManifest.contains("assetIndex")) {
-        QJsonObject ai = ctx.versionManifest["assetIndex"].toObject();
-        std::string url = ai["url"].toString().toStdString();
-        int  sz  = ai["size"].toInt(-1);
-        std::string sha = ai["sha1"].toString().toStdString();
-        if (!validateFile(idxPath, sz, sha)) tasks.push_back({url, idxPath, sz, sha});
-    }
-
-    if (!tasks.empty()) {
-        emit launchLog("  Downloading " + QString::number(tasks.size()) + " file(s)...");
-        bool ok = batchDownload(tasks, 32, [this](int d, int t) {
-            if (d % 20 == 0 || d == t)
-                emit launchLog(QString("  Progress: %1/%2").arg(d).arg(t));
-        });
-        if (!ok) return false;
+bool LauncherCore::assetIndexTask(const QJsonObject& manifest, DownloadTask& out) const {
+    if (!manifest.contains("assetIndex")) return false;
+    std::string assetId = manifest.contains("assets")
+                        ? manifest["assets"].toString().toStdString() : "legacy";
+    QJsonObject ai = manifest["assetIndex"].toObject();
+    out = {ai["url"].toString().toStdString(),
+           (fs::path(workDir) / "assets" / "indexes" / (assetId + ".json")).string(),
+           ai["size"].toInt(-1), ai["sha1"].toString().toStdString(),
+           false, {}, DownloadPriority::Index};
+    return !out.url.empty();
+}
+
+std::vector<LauncherCore::DownloadTask>
+LauncherCore::assetObjectTasks(const std::string& indexPath) const {
+    std::vector<DownloadTask> tasks;
+    QFile f(QString::fromStdString(indexPath));
+    if (!f.open(QIODevice::ReadOnly)) return tasks;
+    const QJsonObject objects = QJsonDocument::fromJson(f.readAll()).object()["objects"].toObject();
+    tasks.reserve(static_cast<size_t>(objects.size()));
+    for (auto it = objects.begin(); it != objects.end(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        std::string hash = obj["hash"].toString().toStdString();
+        if (hash.size() < 2) continue;
+        int  sz  = obj["size"].toInt(-1);
+        std::string sub = hash.substr(0, 2);
+        std::string fp  = (fs::path(workDir) / "assets" / "objects" / sub / hash).string();
+        std::string url = "https://resources.download.minecraft.net/" + sub + "/" + hash;
+        tasks.push_back({url, fp, sz, hash, false, {}, DownloadPriority::Asset});
     }
+    return tasks;
+}
 
-    // Asset objects
-    if (fs::exists(idxPath)) {
-        std::ifstream in(idxPath);
-        std::string s((std::istreambuf_iterator<char>(in)), {});
-        QJsonDocument idxDoc = QJsonDocument::fromJson(QByteArray::fromStdString(s));
-        if (idxDoc.isObject()) {
-            std::vector<DownloadTask> assetTasks;
-            for (auto it = idxDoc.object()["objects"].toObject().begin();
-                 it != idxDoc.object()["objects"].toObject().end(); ++it) {
-                QJsonObject obj = it.value().toObject();
-                std::string hash = obj["hash"].toString().toStdString();
-                int  sz  = obj["size"].toInt(-1);
-                std::string sub = hash.substr(0, 2);
-                std::string fp  = (fs::path(workDir) / "assets" / "objects" / sub / hash).string();
-                std::string url = "https://resources.download.minecraft.net/" + sub + "/" + hash;
-                if (!validateFile(fp, sz, hash)) assetTasks.push_back({url, fp, sz, hash});
-            }
-            if (!assetTasks.empty()) {
-                emit launchLog("  Downloading " + QString::number(assetTasks.size()) + " asset(s)...");
-                batchDownload(assetTasks, 32, [this](int d, int t) {
-                    if (d % 100 == 0 || d == t)
-                        emit launchLog(QString("  Assets: %1/%2").arg(d).arg(t));
-                });
-            }
-        }
+// ── Install pipeline ─────────────────────────────────────────────────────────
+// Everything that depends only on the version JSON starts at once; the only
+// wait is asset objects on their index:
+//
+//   version JSON ──┬── client jar + libraries ─────────────────┐
+//                  └── asset index ── parse ── asset objects ──┴── done
+//
+// The two branches are separate batches over the same engine, host windows
+// and memory budget, so the index request and its parse overlap the jar and
+// libraries instead of waiting behind them. One ProgressMeter spans both.
+LauncherCore::InstallResult
+LauncherCore::installVersionFiles(const std::string& versionId, const QJsonObject& manifest,
+                                  std::function<void(const DownloadProgress&)> progress,
+                                  std::vector<DownloadTask>* deferred) {
+    ProgressMeter meter(&m_bandwidth, 2);
+
+    std::vector<DownloadTask> core = libraryTasks(manifest);
+    DownloadTask jar;
+    if (clientJarTask(versionId, manifest, jar)) core.push_back(jar);
+    if (deferred) deferPresent(core, *deferred);
+    QFuture<bool> coreDone = QtConcurrent::run([this, &core, &progress, &meter]() {
+        return batchDownload(core, progress, &meter);
+    });
+
+    InstallResult r;
+    DownloadTask idx;
+    if (!assetIndexTask(manifest, idx)) {
+        meter.addBatch(0, 0);
+        r.assets = true;
+    } else if (!downloadFile(idx.url, idx.path, idx.size, idx.sha1)) {
+        emit launchLog("  Asset index could not be downloaded");
+        meter.addBatch(0, 0);
+    } else {
+        // Only this thread touches `deferred`; the core batch has its own list.
+        std::vector<DownloadTask> assets = assetObjectTasks(idx.path);
+        if (deferred) deferPresent(assets, *deferred);
+        r.assets = batchDownload(assets, progress, &meter);
     }
-    return true;
+
+    r.core = coreDone.result();
+    return r;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1563,10 +2638,10 @@ std::vector<MinecraftVersion> LauncherCore::getRemoteVersionList() {
     
     // Fetch from BMCLAPI (faster in CN)
     QString url = "https://bmclapi2.bangbang93.com/mc/game/version_manifest_v2.json";
-    QByteArray data = httpGet(url.toStdString());
+    QByteArray data = httpGet(url.toStdString(), nullptr, nullptr, true);
     if (data.isEmpty()) {
         url = "https://piston-meta.mojang.com/mc/game/version_manifest_v2.json";
-        data = httpGet(url.toStdString());
+        data = httpGet(url.toStdString(), nullptr, nullptr, true);
     }
     
     if (data.isEmpty()) return m_remoteVersionsCache; // Return stale cache if fail
@@ -1674,31 +2749,36 @@ void LauncherCore::downloadMinecraftVersion(const std::string& versionId) {
         QString vDir = QString::fromStdString(self->workDir) + "/versions/" + QString::fromStdString(versionId);
         QDir().mkpath(vDir);
         QString jsonPath = vDir + "/" + QString::fromStdString(versionId) + ".json";
-        QFile f(jsonPath);
-        if (f.open(QIODevice::WriteOnly)) {
-            f.write(json);
-            f.close();
-        } else {
+        QSaveFile f(jsonPath);
+        if (!f.open(QIODevice::WriteOnly) || f.write(json) != json.size() || !f.commit()) {
              setStatus("File write error", 0, false, false, "Cannot write version json");
              return;
         }
         
-        // 4. Download Client JAR (Minimal implementation)
+        // 4. Client JAR, libraries, asset index and assets as one pipeline
+        //    (see installVersionFiles); the bar covers 5–100 % by bytes.
         QJsonObject manifest = QJsonDocument::fromJson(json).object();
-        if (manifest.contains("downloads")) {
-             QJsonObject cl = manifest["downloads"].toObject()["client"].toObject();
-             std::string url = cl["url"].toString().toStdString();
-             std::string path = (fs::path(self->workDir) / "versions" / versionId / (versionId + ".jar")).string();
-             int size = cl["size"].toInt();
-             std::string sha1 = cl["sha1"].toString().toStdString();
-             
-             setStatus("Downloading Client JAR...", 50, true);
-             if (!self->validateFile(path, size, sha1)) {
-                 if (!self->downloadFile(url, path, size, sha1)) {
-                      setStatus("Download failed", 0, false, false, "Failed to download client jar");
-                      return;
-                 }
-             }
+        setStatus("Downloading game files...", 5, true);
+        const InstallResult r = self->installVersionFiles(versionId, manifest,
+            [&](const DownloadProgress& p) {
+                if (!self) return;
+                {
+                    QMutexLocker l(&self->m_dlStatusLock);
+                    self->m_dlStatus.transfer = p;
+                }
+                setStatus(QString("Downloading %1 / %2 files...%3")
+                          .arg(p.filesDone).arg(p.filesTotal).arg(transferSuffix(p)),
+                          5 + p.percent() * 95 / 100, true);
+                emit self->downloadProgress("version", p.bytesDone, p.bytesTotal,
+                                            p.bytesPerSec, p.etaMs);
+            });
+        if (!r.core) {
+            setStatus("Download failed", 0, false, false, "Failed to download client jar or libraries");
+            return;
+        }
+        if (!r.assets) {
+            setStatus("Download failed", 0, false, false, "Failed to download assets");
+            return;
         }
         
         setStatus("Download complete", 100, false, true);
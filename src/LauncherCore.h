@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QNetworkAccessManager>
+#include <QNetworkRequest>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -11,10 +12,29 @@
 #include <QtConcurrent>
 #include <QPointer>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QReadWriteLock>
 #include <QDateTime>
+#include <QThread>
+#include <QTimer>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include "MirrorHealth.h"
+#include "HostConcurrency.h"
+#include "BandwidthLimiter.h"
+#include "RetryPolicy.h"
+#include "HttpCache.h"
+#include "Http2Policy.h"
+#include "DiskSync.h"
+#include "ProgressMeter.h"
+#include "MemoryBudget.h"
+#include "LocalMirrors.h"
+#include "NetWarmup.h"
+#include "VerifiedIndex.h"
+#include "RepairQueue.h"
 
 // ════════════════════════════════════════════════════════════════════════════
 // Launch Context – carries all state through the 8-step launch pipeline
@@ -74,6 +94,17 @@ struct JavaStatus {
     std::string statusMsg;
     bool success = false;
     std::string error;
+    DownloadProgress transfer;   // Latest byte progress of the download phase
+};
+
+// Background SHA-1 pass after a fast-verified launch (see startDeepCheck).
+struct IntegrityStatus {
+    bool        running = false;
+    std::string versionId;
+    int         checked = 0;
+    int         total   = 0;
+    int         corrupt = 0;          // Found by the last / current pass
+    int         pendingRepairs = 0;   // Queued for the next launch
 };
 
 // ════════════════════════════════════════════════════════════════════════════
@@ -99,14 +130,20 @@ struct McDownloadStatus {
     std::string statusMsg;
     bool        success  = false;
     std::string error;
+    DownloadProgress transfer;
 };
 
 // ════════════════════════════════════════════════════════════════════════════
 // LauncherCore
 // ════════════════════════════════════════════════════════════════════════════
 
+class DownloadEngine;
+class DownloadSink;
+
 class LauncherCore : public QObject {
     Q_OBJECT
+    friend class DownloadEngine;
+    friend class DownloadSink;
 public:
     explicit LauncherCore(QObject* parent = nullptr);
     ~LauncherCore();
@@ -139,8 +176,9 @@ public:
     JavaStatus getJavaStatus() const;
 
     // ── Minecraft version download ────────────────────────────────────────────
-    // Async 3-phase pipeline: manifest → assets+libs → client jar.
-    // Emits mcDownloadProgress / mcDownloadFinished.
+    // Async: version JSON, then client jar + libraries and asset index →
+    // assets concurrently (see installVersionFiles).
+    // Emits mcDownloadProgress / mcDownloadFinished / downloadProgress.
     void downloadMinecraftVersion(const std::string& versionId);
     McDownloadStatus getDownloadStatus() const;
 
@@ -165,7 +203,7 @@ public:
     //     • Download and parse the component manifest → DownloadTask list.
     //
     //   Phase 2 – JavaDownloadLoader:
-    //     • Batch-download all files with 32 parallel threads.
+    //     • Batch-download all files (per-mirror adaptive parallelism).
     //     • Mirror: piston-data.mojang.com → bmclapi2.bangbang93.com.
     //     • Per-file SHA1 + size validation.
     //     • On any failure → delete target dir (prevent corrupt install).
@@ -178,6 +216,13 @@ public:
     void installJava(int majorVersion);
 
     // ── Download infrastructure ───────────────────────────────────────────────
+    // Scheduling class of a DownloadTask; lower values are fetched first.
+    //   Critical – client jar, libraries, natives (needed to launch)
+    //   Index    – asset index
+    //   Normal   – untagged work (e.g. Java runtime files)
+    //   Asset    – asset objects
+    enum class DownloadPriority { Critical, Index, Normal, Asset };
+
     struct DownloadTask {
         std::string url;
         std::string path;
@@ -185,11 +230,70 @@ public:
         std::string sha1;
         bool        extract       = false;
         std::string extractTarget;
+        DownloadPriority priority = DownloadPriority::Normal;
     };
 
+    // Scheduling order used by batchDownload and DownloadEngine: priority
+    // class first, then largest file first so a big jar never starts last
+    // and sets the finish time. Unknown sizes go after known ones.
+    static bool scheduledBefore(const DownloadTask& a, const DownloadTask& b);
+
+    // Files of at least `thresholdBytes` are fetched as `segments` parallel
+    // byte ranges, spread across mirrors, into one preallocated file.
+    // Persisted in workDir/download.ini; thresholdBytes <= 0 disables it.
+    void setSegmentedDownload(qint64 thresholdBytes, int segments);
+    qint64 getSegmentThreshold() const { return m_segmentThreshold.load(); }
+    int    getSegmentCount() const { return m_segmentCount.load(); }
+
+    // ThreadPool – one blocking request per worker thread (legacy path).
+    // Async      – workers only verify files; transfers are multiplexed by
+    //              DownloadEngine, so the thread count no longer caps the network.
+    // Persisted in workDir/download.ini ([download] backend=async|threads).
+    enum class DownloadBackend { ThreadPool, Async };
+    void setDownloadBackend(DownloadBackend backend);
+    DownloadBackend getDownloadBackend() const { return m_backend.load(); }
+
+    // Full – stepFixFiles checks size and SHA-1 of every file before launch.
+    // Fast – files that exist with their manifest size are trusted; their
+    //        SHA-1 is checked on an idle-priority thread once the game has
+    //        started, and failures are repaired before the next launch.
+    // Persisted in workDir/download.ini ([download] verifyMode=full|fast).
+    enum class VerifyMode { Full, Fast };
+    void setVerifyMode(VerifyMode mode);
+    VerifyMode getVerifyMode() const { return m_verifyMode.load(); }
+    IntegrityStatus getIntegrityStatus() const;
+
+    // Live mirror scores, best first within each host family.
+    std::vector<MirrorScore> getMirrorHealth() const;
+
+    // Current AIMD concurrency window per host.
+    std::vector<HostLimit> getHostLimits() const;
+
+    // Global download rate cap in bytes/s (0 = unlimited) and an optional
+    // time-of-day override, e.g. "09:00-18:00=1M,22:00-07:00=0". Applied
+    // live and persisted in workDir/download.ini. setBandwidthSchedule
+    // returns false (and changes nothing) for a malformed schedule.
+    void setBandwidthLimit(qint64 bytesPerSec);
+    bool setBandwidthSchedule(const QString& schedule);
+    BandwidthStatus getBandwidthStatus();
+
+    // Ceiling on memory held by in-flight transfers (see MemoryBudget);
+    // 0 = unlimited. Applied live, persisted as [download] memoryBudgetBytes.
+    void setMemoryBudget(qint64 bytes);
+    MemoryStatus getMemoryStatus() const;
+
+    // Per-host DNS answer and pre-connect timings from startup warm-up.
+    std::vector<WarmHost> getWarmupStatus() const;
+
+    // Network parallelism is decided per host by HostConcurrency; callers
+    // no longer pass a thread count. progressCallback is invoked on the
+    // calling thread only, at most every ProgressMeter::REPORT_INTERVAL_MS,
+    // and once more with finished=true. Batches running side by side can
+    // share one `sharedMeter` (see ProgressMeter) to report as a whole; the
+    // callback then runs on whichever caller is polling, never concurrently.
     bool batchDownload(const std::vector<DownloadTask>& tasks,
-                       int maxThreads = 32,
-                       std::function<void(int /*done*/, int /*total*/)> progressCallback = nullptr);
+                       std::function<void(const DownloadProgress&)> progressCallback = nullptr,
+                       ProgressMeter* sharedMeter = nullptr);
 
 signals:
     // ── Java install signals ─────────────────────────────────────────────────
@@ -205,6 +309,10 @@ signals:
     void mcDownloadProgress(int percent, QString message);
     void mcDownloadFinished(bool success, QString versionId, QString error);
 
+    // ── Byte progress of a running batch ("java" | "launch" | "version") ─────
+    void downloadProgress(QString job, qint64 bytesDone, qint64 bytesTotal,
+                          double bytesPerSec, qint64 etaMs);
+
     // ── Launch signals ────────────────────────────────────────────────────────
     void launchLog(QString message);
     void gameStarted();
@@ -215,6 +323,124 @@ private:
     std::string            workDir;
     QNetworkAccessManager* networkManager;
 
+    // ── Download worker pool ──────────────────────────────────────────────────
+    // Long-lived so its threads (and the per-thread QNetworkAccessManager each
+    // one owns) survive across tasks and batches; idle threads retire after
+    // the pool's expiry timeout, taking their session with them.
+    QThreadPool m_downloadPool;
+
+    // ── Verification pool ─────────────────────────────────────────────────────
+    // Size + SHA1 checks of the async backend, sized for the disk and CPU
+    // ([download] verifyDepth, 0 = one per core, at least 4) and never
+    // blocked by a transfer, so files needing a download reach the engine
+    // as fast as they are found.
+    QThreadPool m_verifyPool;
+
+    // ── Segmented download ────────────────────────────────────────────────────
+    // Separate pool so segments of a file being fetched by an m_downloadPool
+    // worker never wait behind that same pool's queue.
+    QThreadPool         m_segmentPool;
+    std::atomic<qint64> m_segmentThreshold{16 * 1024 * 1024};
+    std::atomic<int>    m_segmentCount{4};
+
+    // ── Async download engine ─────────────────────────────────────────────────
+    QThread                      m_engineThread;
+    DownloadEngine*              m_engine = nullptr;
+    std::atomic<DownloadBackend> m_backend{DownloadBackend::Async};
+
+    bool batchDownloadAsync(const std::vector<DownloadTask>& tasks,
+                            std::function<void(const DownloadProgress&)> progressCallback,
+                            ProgressMeter& meter);
+    static qint64 knownBytes(const std::vector<DownloadTask>& tasks);
+    // Waits for `done` to reach `total`, feeding progressCallback from the
+    // meter on the calling thread.
+    static void awaitBatch(ProgressMeter& meter, QMutex& waitLock, QWaitCondition& allDone,
+                           const std::atomic<int>& done, int total,
+                           const std::function<void(const DownloadProgress&)>& progressCallback);
+
+    // ── Mirror health (TTFB / throughput / errors per family+mirror) ──────────
+    MirrorHealth m_mirrorHealth;
+
+    // ── Per-host AIMD concurrency (replaces fixed maxThreads) ─────────────────
+    HostConcurrency m_hostLimits;
+
+    // ── Global token-bucket rate limit for all download bodies ────────────────
+    BandwidthLimiter m_bandwidth;
+
+    // ── Directory / LAN copies of workDir trees, tried before public mirrors ──
+    LocalMirrors m_localMirrors;
+
+    // ── Startup DNS pre-resolution and connection warm-up ────────────────────
+    NetWarmup m_warmup;
+    // Main thread. Re-resolves expired hosts on a worker every
+    // WARMUP_REFRESH_MS so no batch ever waits on DNS bookkeeping.
+    static constexpr int WARMUP_REFRESH_MS = 15000;
+    QTimer        m_warmupTimer;
+    QFuture<void> m_warmupRefresh;   // Joined by ~LauncherCore
+    void refreshWarmupAsync();
+    // Hosts the mirror lists can point at, plus any LAN HTTP mirrors.
+    QStringList warmupUrls() const;
+    // Main thread, after resolution: opens connections on the engine's and
+    // networkManager's pools and logs the per-host timings.
+    void prewarmConnections(const QStringList& urls);
+
+    // ── In-flight memory ceiling, charged per transfer ───────────────────────
+    MemoryBudget m_memory;
+    // Charge for `t`: one stream, or one per segment above the threshold.
+    qint64 transferCost(const DownloadTask& t) const;
+
+    // ── Verified files renamed into place, synced once per batch ─────────────
+    DiskSync m_diskSync;
+    // Stat-keyed record of verified SHA1s, saved after each flush.
+    VerifiedIndex m_verified;
+    // m_diskSync.commit() for a body that matched `sha1`, recording it in
+    // m_verified so the next validateFile() needn't hash it again.
+    bool commitVerified(const std::string& tmp, const std::string& dst,
+                        const std::string& sha1, std::error_code& ec);
+
+    // ── Per-host HTTP/2 opt-in / downgrade (see Http2Policy) ──────────────────
+    Http2Policy m_http2;
+
+    // ── Conditional-GET cache for metadata (workDir/cache/http) ───────────────
+    HttpCache m_httpCache;
+
+    // ── Retry rounds, backoff, timeouts and per-host circuit breakers ─────────
+    // m_retry is loaded once in init() and read-only afterwards.
+    RetryPolicy     m_retry;
+    CircuitBreakers m_breakers;
+    // Feeds m_breakers and logs when a host's breaker opens or closes.
+    void recordHostOutcome(const QString& host, const MirrorHealth::Sample& s);
+
+    // ── In-flight transfers shared across concurrent batches ──────────────────
+    // A launch repair and a version install can ask for the same object at the
+    // same time. The first to claim a destination path downloads it; everyone
+    // else registers a continuation instead of writing the same .part file.
+    // Nobody blocks a thread on a claim: the owner may itself still be queued
+    // behind that thread's pool.
+    using SettledFn = std::function<void(bool ok)>;
+    // True if the caller now owns `path` and must settleTransfer() it.
+    // Otherwise `onSettled` runs once the owner settles, on the owner's
+    // thread, so it must not block.
+    bool claimTransfer(const std::string& path, SettledFn onSettled);
+    void settleTransfer(const std::string& path, bool ok);
+
+    struct InFlight {
+        std::vector<SettledFn> waiters;
+    };
+    QMutex                                    m_inFlightLock;
+    std::unordered_map<std::string, InFlight> m_inFlight;   // Keyed by destination path
+
+    // ── Connection reuse instrumentation ──────────────────────────────────────
+    // requests       – every GET issued through httpGet / httpDownloadToFile
+    // newConnections – replies that had to open a socket (no keep-alive hit)
+    // handshakeMs    – summed connect + TLS time of those new sockets
+    struct NetSessionStats {
+        std::atomic<qint64> requests{0};
+        std::atomic<qint64> newConnections{0};
+        std::atomic<qint64> handshakeMs{0};
+    };
+    NetSessionStats m_netStats;
+
     // Protected by javaListLock (many readers, one writer)
     mutable QReadWriteLock javaListLock;
     QVector<JavaEntry>     javaList;
@@ -256,7 +482,13 @@ private:
 
     // ── JavaDownloadLoader internals ─────────────────────────────────────────
     // Build mirror-prioritised URL list and apply mirror substitution.
+    // The static candidate order is re-ranked by live MirrorHealth scores.
     QStringList buildMirrorUrls(const QString& originalUrl) const;
+    // buildMirrorUrls plus, ahead of it, any LAN HTTP mirror copies of `path`.
+    QStringList candidateUrls(const std::string& url, const std::string& path) const;
+    // Links/copies `path` from a directory mirror (see LocalMirrors),
+    // verifies it and renames it into place. False if no root had it.
+    bool placeFromLocal(const std::string& path, int size, const std::string& sha1);
 
     // Resolve the cached java path for the launch pipeline.
     QString findJavaPath(int majorVersion) const;
@@ -270,9 +502,63 @@ private:
     bool validateFile(const std::string& filepath, int size, const std::string& sha1);
     bool extractNative(const std::string& archivePath, const std::string& targetDir);
 
+    // Shared request setup (HTTP/1.1, SSL, redirects, UA) for every GET.
+    QNetworkRequest buildRequest(const std::string& url) const;
+    // Hooks a reply into m_netStats (new socket vs. reused keep-alive).
+    void trackConnection(QNetworkReply* reply);
+    // Logs how much connect/TLS time session reuse saved since `before*`.
+    void reportConnectionReuse(qint64 requestsBefore, qint64 connsBefore,
+                               qint64 handshakeMsBefore);
+
+    // `cached` = revalidate against m_httpCache (If-None-Match /
+    // If-Modified-Since); a 304 returns the stored body. Meant for mutable
+    // metadata (version manifests, all.json), not for artifacts.
     QByteArray httpGet(const std::string& url,
                        bool* success = nullptr,
-                       QNetworkAccessManager* nam = nullptr);
+                       QNetworkAccessManager* nam = nullptr,
+                       bool cached = false);
+
+    // Resume state of a <file>.part, persisted beside it as <file>.part.json
+    // so an interrupted body survives mirror switches and process restarts.
+    struct PartialDownload {
+        std::string sha1;           // Expected SHA1 / size: identify the file
+        int         size = -1;      // independently of which mirror served it
+        qint64      offset = 0;     // Bytes already on disk
+        QByteArray  etag;           // Validators of `source`, sent as If-Range
+        QByteArray  lastModified;
+        QString     source;         // Mirror URL the bytes came from
+        bool        discard = false;// Set when the part can no longer be resumed
+    };
+    static PartialDownload loadPartial(const std::string& tmpPath, int size,
+                                       const std::string& sha1);
+    static void savePartial(const std::string& tmpPath, const PartialDownload& part);
+    static void removePartial(const std::string& tmpPath);
+
+    // Streams a GET straight into `tmpPath` as readyRead fires, feeding each
+    // chunk into SHA1 on the way. Aborts as soon as the body grows past
+    // expectedSize; fails if it ends short of it. Never buffers the body.
+    // With `resume`, continues an existing .part via a Range request.
+    bool httpDownloadToFile(const std::string& url,
+                            const std::string& tmpPath,
+                            int expectedSize,
+                            std::string* sha1Out,
+                            QNetworkAccessManager* nam = nullptr,
+                            PartialDownload* resume = nullptr,
+                            MirrorHealth::Sample* sampleOut = nullptr);
+
+    // Streams bytes [begin, end] of `url` into `tmpPath` at offset `begin`.
+    // Requires a 206 with a matching Content-Range; the file must exist.
+    bool httpFetchRange(const std::string& url,
+                        const std::string& tmpPath,
+                        qint64 begin, qint64 end,
+                        QNetworkAccessManager* nam,
+                        MirrorHealth::Sample* sampleOut = nullptr);
+    // Large-file path of downloadFile: parallel ranges → SHA1 → rename.
+    bool downloadSegmented(const std::string& originalUrl,
+                           const QStringList& urls,
+                           const std::string& path,
+                           int size,
+                           const std::string& sha1);
 
     bool downloadFile(const std::string& url,
                       const std::string& filepath,
@@ -280,6 +566,43 @@ private:
                       const std::string& sha1 = "",
                       QNetworkAccessManager* nam = nullptr);
 
+    // ── Version file sets (install pipeline and stepFixFiles) ─────────────────
+    // Unverified tasks; batchDownload checks the files on disk in parallel.
+    // libraryTasks appends each library artifact to `classPath` if given.
+    std::vector<DownloadTask> libraryTasks(const QJsonObject& manifest,
+                                           std::string* classPath = nullptr) const;
+    bool clientJarTask(const std::string& versionId, const QJsonObject& manifest,
+                       DownloadTask& out) const;
+    bool assetIndexTask(const QJsonObject& manifest, DownloadTask& out) const;
+    std::vector<DownloadTask> assetObjectTasks(const std::string& indexPath) const;
+
+    // Fetches every file a version needs as a dependency graph (jar and
+    // libraries alongside index → assets). `core` = jar and libraries.
+    struct InstallResult { bool core = false; bool assets = false; };
+    // With `deferred`, files passing the fast check (deferPresent) are moved
+    // there instead of being verified.
+    InstallResult installVersionFiles(const std::string& versionId, const QJsonObject& manifest,
+                                      std::function<void(const DownloadProgress&)> progress,
+                                      std::vector<DownloadTask>* deferred = nullptr);
+
+    // ── Tiered verification ───────────────────────────────────────────────────
+    std::atomic<VerifyMode> m_verifyMode{VerifyMode::Full};
+    RepairQueue             m_repairs;
+    mutable QMutex          m_integrityLock;
+    IntegrityStatus         m_integrity;
+    std::vector<DownloadTask> m_deferredChecks;   // From the last fast stepFixFiles
+    // Moves tasks whose file exists with the expected size (and isn't queued
+    // for repair) from `tasks` to `deferred`.
+    void deferPresent(std::vector<DownloadTask>& tasks, std::vector<DownloadTask>& deferred) const;
+    // Hashes m_deferredChecks on an idle-priority thread; failures go to
+    // m_repairs. Called once the game process is running.
+    void startDeepCheck(const std::string& versionId);
+    // The launcher may close while the game (and so the check) still runs:
+    // ~LauncherCore raises the stop flag and joins the thread before any
+    // member it touches is destroyed.
+    QThread*          m_deepCheck = nullptr;
+    std::atomic<bool> m_deepCheckStop{false};
+
     // ── Launch pipeline steps ─────────────────────────────────────────────────
     bool stepCheckJava(LaunchContext& ctx);
     bool stepFixFiles(LaunchContext& ctx);
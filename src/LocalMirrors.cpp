@@ -0,0 +1,83 @@
+// LocalMirrors.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Directory / LAN mirrors laid out like workDir.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "LocalMirrors.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QUrl>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+void LocalMirrors::configure(const QStringList& roots, const QString& workDir) {
+    QMutexLocker lk(&m_lock);
+    m_workDir = QDir(workDir).absolutePath();
+    m_dirs.clear();
+    m_http.clear();
+    for (QString r : roots) {
+        r = r.trimmed();
+        if (r.isEmpty()) continue;
+        if (r.startsWith("http://") || r.startsWith("https://")) {
+            while (r.endsWith('/')) r.chop(1);
+            m_http << r;
+            continue;
+        }
+        if (r.startsWith("file:")) r = QUrl(r).toLocalFile();
+        // A root that is the workDir itself would link files onto themselves.
+        const QString dir = QDir(r).absolutePath();
+        if (dir != m_workDir) m_dirs << dir;
+    }
+}
+
+QStringList LocalMirrors::roots() const {
+    QMutexLocker lk(&m_lock);
+    return m_dirs + m_http;
+}
+
+QString LocalMirrors::relativeOf(const std::string& path) const {
+    if (m_workDir.isEmpty()) return {};
+    const QString abs = QFileInfo(QString::fromStdString(path)).absoluteFilePath();
+    if (!abs.startsWith(m_workDir + "/")) return {};
+    return abs.mid(m_workDir.size() + 1);
+}
+
+std::vector<std::string> LocalMirrors::filesFor(const std::string& path) const {
+    QMutexLocker lk(&m_lock);
+    std::vector<std::string> out;
+    if (m_dirs.isEmpty()) return out;
+    const QString rel = relativeOf(path);
+    if (rel.isEmpty()) return out;
+    for (const QString& dir : m_dirs) {
+        const QString src = dir + "/" + rel;
+        if (QFileInfo(src).isFile()) out.push_back(src.toStdString());
+    }
+    return out;
+}
+
+QStringList LocalMirrors::urlsFor(const std::string& path) const {
+    QMutexLocker lk(&m_lock);
+    QStringList out;
+    if (m_http.isEmpty()) return out;
+    const QString rel = relativeOf(path);
+    if (rel.isEmpty()) return out;
+    const QString encoded = QString::fromUtf8(QUrl::toPercentEncoding(rel, "/"));
+    for (const QString& base : m_http) out << base + "/" + encoded;
+    return out;
+}
+
+bool LocalMirrors::materialise(const std::string& src, const std::string& dst) {
+    std::error_code ec;
+    fs::remove(dst, ec);
+    fs::create_hard_link(src, dst, ec);
+    if (!ec) { ++m_linked; return true; }
+    // EXDEV and friends: fall back to a copy the kernel can do on its own.
+    ec.clear();
+    fs::copy_file(src, dst, fs::copy_options::overwrite_existing, ec);
+    if (!ec) { ++m_copied; return true; }
+    fs::remove(dst, ec);
+    return false;
+}
@@ -0,0 +1,58 @@
+#ifndef LOCALMIRRORS_H
+#define LOCALMIRRORS_H
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// LocalMirrors – copies of workDir trees on local disk, NFS/SMB or the LAN
+//
+// A root mirrors workDir's layout (assets/objects/xx/<hash>, libraries/…,
+// versions/<id>/<id>.jar, runtime/…), so a file is found by its path
+// relative to workDir, independent of which public URL it comes from.
+// Configured in download.ini as [download] localMirrors, a comma list of
+// directories, file:// URLs or http(s):// base URLs.
+//
+// Directory roots are tried before any network request (LauncherCore::
+// placeFromLocal): materialise() hardlinks the file next to its target when
+// both sit on the same filesystem and otherwise copies it with
+// std::filesystem::copy_file, which lets the kernel do the copy. HTTP roots
+// are returned by urlsFor() and go ahead of the public mirrors in the
+// normal download path. Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class LocalMirrors {
+public:
+    void configure(const QStringList& roots, const QString& workDir);
+
+    QStringList roots() const;
+
+    // Existing files for `path` under the directory roots, in configured order.
+    std::vector<std::string> filesFor(const std::string& path) const;
+    // Candidate URLs for `path` on the HTTP roots, in configured order.
+    QStringList urlsFor(const std::string& path) const;
+
+    // Hardlinks `src` to `dst`, or copies it when a link is not possible
+    // (other filesystem, FAT, no permission). False if neither worked.
+    bool materialise(const std::string& src, const std::string& dst);
+
+    qint64 linked() const { return m_linked.load(); }
+    qint64 copied() const { return m_copied.load(); }
+
+private:
+    // Path of `path` relative to workDir, '/'-separated; empty if outside.
+    QString relativeOf(const std::string& path) const;   // m_lock held
+
+    mutable QMutex      m_lock;
+    QString             m_workDir;
+    QStringList         m_dirs;    // Absolute directories
+    QStringList         m_http;    // Base URLs without trailing '/'
+    std::atomic<qint64> m_linked{0};
+    std::atomic<qint64> m_copied{0};
+};
+
+#endif // LOCALMIRRORS_H
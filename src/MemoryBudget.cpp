@@ -0,0 +1,87 @@
+// MemoryBudget.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Admission control for in-flight download memory.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "MemoryBudget.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+
+MemoryBudget::Lease::Lease(Lease&& o) noexcept : m_owner(o.m_owner), m_bytes(o.m_bytes) {
+    o.m_owner = nullptr;
+    o.m_bytes = 0;
+}
+
+MemoryBudget::Lease& MemoryBudget::Lease::operator=(Lease&& o) noexcept {
+    if (this != &o) {
+        reset();
+        m_owner   = o.m_owner;
+        m_bytes   = o.m_bytes;
+        o.m_owner = nullptr;
+        o.m_bytes = 0;
+    }
+    return *this;
+}
+
+void MemoryBudget::Lease::reset() {
+    if (m_owner) m_owner->release(m_bytes);
+    m_owner = nullptr;
+    m_bytes = 0;
+}
+
+qint64 MemoryBudget::costOf(qint64 size, int streams) {
+    const qint64 perStream = size > 0 ? std::min(size, STREAM_BYTES) : STREAM_BYTES;
+    return perStream * std::max(1, streams);
+}
+
+bool MemoryBudget::fits(qint64 bytes) const {
+    return m_limit <= 0 || m_inUse == 0 || m_inUse + bytes <= m_limit;
+}
+
+void MemoryBudget::admit(qint64 bytes) {
+    m_inUse += bytes;
+    m_peak   = std::max(m_peak, m_inUse);
+    ++m_leases;
+}
+
+MemoryBudget::Lease MemoryBudget::acquire(qint64 bytes) {
+    QMutexLocker lk(&m_lock);
+    ++m_waiting;
+    while (!fits(bytes)) m_freed.wait(&m_lock);
+    --m_waiting;
+    admit(bytes);
+    return Lease(this, bytes);
+}
+
+MemoryBudget::Lease MemoryBudget::tryAcquire(qint64 bytes) {
+    QMutexLocker lk(&m_lock);
+    // Blocked workers were first; don't let the engine overtake them.
+    if (m_waiting > 0 || !fits(bytes)) return Lease();
+    admit(bytes);
+    return Lease(this, bytes);
+}
+
+void MemoryBudget::release(qint64 bytes) {
+    QMutexLocker lk(&m_lock);
+    m_inUse -= bytes;
+    --m_leases;
+    m_freed.wakeAll();
+}
+
+void MemoryBudget::setLimit(qint64 bytes) {
+    QMutexLocker lk(&m_lock);
+    m_limit = std::max<qint64>(0, bytes);
+    m_freed.wakeAll();
+}
+
+MemoryStatus MemoryBudget::status() const {
+    QMutexLocker lk(&m_lock);
+    MemoryStatus s;
+    s.limitBytes = m_limit;
+    s.inUseBytes = m_inUse;
+    s.peakBytes  = m_peak;
+    s.leases     = m_leases;
+    s.waiting    = m_waiting;
+    return s;
+}
@@ -0,0 +1,82 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtGlobal>
+
+// ════════════════════════════════════════════════════════════════════════════
+// MemoryStatus – GET /api/download/memory
+// ════════════════════════════════════════════════════════════════════════════
+
+struct MemoryStatus {
+    qint64 limitBytes = 0;   // 0 = unlimited
+    qint64 inUseBytes = 0;
+    qint64 peakBytes  = 0;   // Since startup
+    int    leases     = 0;   // Transfers currently admitted
+    int    waiting    = 0;   // Blocked in acquire()
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// MemoryBudget – ceiling on memory held by in-flight downloads
+//
+// Every transfer is admitted with a charge of costOf(size): its declared
+// size, capped at STREAM_BYTES because bodies are streamed to disk and a
+// transfer never holds more than its reply read buffer plus one chunk.
+// Metadata-sized files therefore cost what they are, and the ceiling bounds
+// peak RSS however the scheduler mixes big and small files. Work over the
+// limit queues: acquire() blocks (pool workers), tryAcquire() returns an
+// empty lease (DownloadEngine keeps the task pending). A single charge
+// larger than the whole limit is admitted alone so it cannot wait forever.
+// Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class MemoryBudget {
+public:
+    static constexpr qint64 STREAM_BYTES = 512 * 1024;
+
+    // Releases its charge on destruction or reset(). Move-only.
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& o) noexcept;
+        Lease& operator=(Lease&& o) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { reset(); }
+
+        void reset();
+        bool held() const { return m_owner != nullptr; }
+
+    private:
+        friend class MemoryBudget;
+        Lease(MemoryBudget* owner, qint64 bytes) : m_owner(owner), m_bytes(bytes) {}
+        MemoryBudget* m_owner = nullptr;
+        qint64        m_bytes = 0;
+    };
+
+    // Charge for one transfer of `size` bytes (unknown ≤ 0) over `streams`
+    // parallel connections.
+    static qint64 costOf(qint64 size, int streams = 1);
+
+    Lease acquire(qint64 bytes);
+    Lease tryAcquire(qint64 bytes);
+
+    void setLimit(qint64 bytes);   // 0 = unlimited; wakes waiters
+    MemoryStatus status() const;
+
+private:
+    bool fits(qint64 bytes) const;   // m_lock held
+    void admit(qint64 bytes);        // m_lock held
+    void release(qint64 bytes);
+
+    mutable QMutex m_lock;
+    QWaitCondition m_freed;
+    qint64         m_limit   = 0;
+    qint64         m_inUse   = 0;
+    qint64         m_peak    = 0;
+    int            m_leases  = 0;
+    int            m_waiting = 0;
+};
+
+#endif // MEMORYBUDGET_H
@@ -0,0 +1,113 @@
+// MirrorHealth.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Live mirror scoring: EWMA throughput / TTFB / error rate per
+//  (family, mirror) pair and cost-based re-ranking of mirror candidates.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "MirrorHealth.h"
+
+#include <QMutexLocker>
+#include <QUrl>
+#include <algorithm>
+
+// ── Tuning ───────────────────────────────────────────────────────────────────
+
+static constexpr double EWMA_ALPHA         = 0.2;          // Weight of the newest sample
+static constexpr qint64 MIN_SIZED_BYTES    = 64 * 1024;    // Smaller bodies are all TTFB
+static constexpr int    MIN_SAMPLES        = 3;            // Below this, use the prior
+static constexpr int    EXPLORE_EVERY      = 20;           // rank() calls per exploration
+static constexpr double REFERENCE_BYTES    = 1024 * 1024;  // Cost = time for this much
+static constexpr double PRIOR_THROUGHPUT   = 2.0 * 1024 * 1024;
+static constexpr double PRIOR_TTFB_MS      = 300.0;
+static constexpr double MIN_THROUGHPUT_BPS = 1024.0;
+
+static QString hostOf(const QString& url) {
+    return QUrl(url).host().toLower();
+}
+
+QString MirrorHealth::key(const QString& family, const QString& mirror) {
+    return family + '|' + mirror;
+}
+
+// Expected seconds to fetch REFERENCE_BYTES from this mirror, inflated by the
+// chance of having to go elsewhere: t / (1 - p). Mirrors without enough
+// samples are scored with a neutral prior so a degrading favourite is
+// overtaken by a candidate we haven't measured yet.
+double MirrorHealth::cost(const Stats& s) {
+    const double thr  = s.sizedSamples > 0 ? s.throughputBps : PRIOR_THROUGHPUT;
+    const double ttfb = s.samples >= MIN_SAMPLES ? s.ttfbMs : PRIOR_TTFB_MS;
+    const double err  = s.samples >= MIN_SAMPLES ? std::min(s.errorRate, 0.95) : 0.0;
+    const double t    = ttfb / 1000.0 + REFERENCE_BYTES / std::max(thr, MIN_THROUGHPUT_BPS);
+    return t / (1.0 - err);
+}
+
+void MirrorHealth::record(const QString& originalUrl, const QString& mirrorUrl,
+                          const Sample& s) {
+    const QString k = key(hostOf(originalUrl), hostOf(mirrorUrl));
+    QMutexLocker lk(&m_lock);
+    Stats& st = m_stats[k];
+
+    auto ewma = [](double prev, double v, bool first) {
+        return first ? v : prev + EWMA_ALPHA * (v - prev);
+    };
+
+    const bool first = st.samples == 0;
+    st.errorRate = ewma(st.errorRate, s.ok ? 0.0 : 1.0, first);
+    if (s.ttfbMs >= 0) st.ttfbMs = ewma(st.ttfbMs, double(s.ttfbMs), first);
+    // Throughput only from bodies big enough to be bandwidth-bound.
+    if (s.ok && s.bytes >= MIN_SIZED_BYTES && s.elapsedMs > 0) {
+        const double bodyMs = std::max<double>(1.0, double(s.elapsedMs) - std::max<qint64>(0, s.ttfbMs));
+        st.throughputBps = ewma(st.throughputBps, s.bytes * 1000.0 / bodyMs,
+                                st.sizedSamples == 0);
+        ++st.sizedSamples;
+    }
+    ++st.samples;
+}
+
+QStringList MirrorHealth::rank(const QString& originalUrl, const QStringList& urls) const {
+    if (urls.size() < 2) return urls;
+    const QString family = hostOf(originalUrl);
+
+    QMutexLocker lk(&m_lock);
+    struct Candidate { QString url; double cost; int samples; };
+    std::vector<Candidate> c;
+    c.reserve(static_cast<size_t>(urls.size()));
+    for (const QString& u : urls) {
+        const Stats s = m_stats.value(key(family, hostOf(u)));
+        c.push_back({ u, cost(s), s.samples });
+    }
+    std::stable_sort(c.begin(), c.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+
+    if (++m_rankCalls[family] % EXPLORE_EVERY == 0) {
+        auto least = std::min_element(c.begin(), c.end(),
+            [](const Candidate& a, const Candidate& b) { return a.samples < b.samples; });
+        std::rotate(c.begin(), least, least + 1);
+    }
+
+    QStringList out;
+    for (const Candidate& x : c) out << x.url;
+    return out;
+}
+
+std::vector<MirrorScore> MirrorHealth::snapshot() const {
+    QMutexLocker lk(&m_lock);
+    std::vector<MirrorScore> out;
+    out.reserve(static_cast<size_t>(m_stats.size()));
+    for (auto it = m_stats.cbegin(); it != m_stats.cend(); ++it) {
+        const QStringList parts = it.key().split('|');
+        MirrorScore m;
+        m.family        = parts.value(0).toStdString();
+        m.mirror        = parts.value(1).toStdString();
+        m.throughputBps = it->throughputBps;
+        m.ttfbMs        = it->ttfbMs;
+        m.errorRate     = it->errorRate;
+        m.samples       = it->samples;
+        m.cost          = cost(*it);
+        out.push_back(m);
+    }
+    std::sort(out.begin(), out.end(), [](const MirrorScore& a, const MirrorScore& b) {
+        return a.family != b.family ? a.family < b.family : a.cost < b.cost;
+    });
+    return out;
+}
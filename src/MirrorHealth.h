@@ -0,0 +1,73 @@
+#ifndef MIRRORHEALTH_H
+#define MIRRORHEALTH_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <string>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// MirrorScore – one row of the live mirror ranking (GET /api/download/mirrors)
+// ════════════════════════════════════════════════════════════════════════════
+
+struct MirrorScore {
+    std::string family;              // Host of the original (Mojang) URL
+    std::string mirror;              // Host that actually served the bytes
+    double      throughputBps = 0;   // EWMA over transfers ≥ 64 KiB
+    double      ttfbMs        = 0;   // EWMA time to first byte
+    double      errorRate     = 0;   // EWMA of failures (0..1)
+    int         samples       = 0;
+    double      cost          = 0;   // Lower is better; see MirrorHealth::cost
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// MirrorHealth – per-session mirror scoring
+//
+// Every finished transfer reports TTFB, bytes, duration and outcome for the
+// (family, mirror) pair it used. buildMirrorUrls asks rank() to reorder its
+// static candidate list, so new tasks go to the mirror that is currently
+// cheapest instead of always bmclapi2 → mcbbs → Mojang. Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class MirrorHealth {
+public:
+    // Outcome of one transfer attempt; also feeds HostConcurrency.
+    struct Sample {
+        bool   ok        = false;
+        qint64 ttfbMs    = -1;   // -1 = no response headers seen
+        qint64 bytes     = 0;
+        qint64 elapsedMs = 0;
+        int    httpCode  = 0;
+        bool   reset     = false; // Connection refused / closed / reset
+        bool   stalled   = false; // Aborted by an inactivity timeout
+    };
+
+    void record(const QString& originalUrl, const QString& mirrorUrl, const Sample& s);
+
+    // Stable re-order of `urls` (all candidates for `originalUrl`) by cost.
+    // Every EXPLORE_EVERY-th call per family promotes the least-sampled
+    // candidate so scores of idle mirrors don't go stale.
+    QStringList rank(const QString& originalUrl, const QStringList& urls) const;
+
+    std::vector<MirrorScore> snapshot() const;
+
+private:
+    struct Stats {
+        double throughputBps = 0;
+        double ttfbMs        = 0;
+        double errorRate     = 0;
+        int    samples       = 0;
+        int    sizedSamples  = 0;   // Samples that fed throughputBps
+    };
+
+    static double cost(const Stats& s);
+    static QString key(const QString& family, const QString& mirror);
+
+    mutable QMutex              m_lock;
+    QHash<QString, Stats>       m_stats;       // key(family, mirror) → stats
+    mutable QHash<QString, int> m_rankCalls;   // family → rank() calls
+};
+
+#endif // MIRRORHEALTH_H
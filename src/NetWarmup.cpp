@@ -0,0 +1,119 @@
+// NetWarmup.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Parallel DNS pre-resolution with TTL bookkeeping.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "NetWarmup.h"
+
+#include <QDnsLookup>
+#include <QEventLoop>
+#include <QHostInfo>
+#include <QMutexLocker>
+#include <QTimer>
+#include <algorithm>
+
+// A resolver that hasn't answered by then won't help the first request either.
+static constexpr int LOOKUP_TIMEOUT_MS = 5000;
+
+std::vector<WarmHost> NetWarmup::lookup(const QStringList& hosts) {
+    std::vector<WarmHost> out(static_cast<size_t>(hosts.size()));
+    QElapsedTimer clock;
+    clock.start();
+    QEventLoop loop;
+    int pending = 0;
+    auto settle = [&]() { if (--pending == 0) loop.quit(); };
+
+    for (int i = 0; i < hosts.size(); ++i) {
+        WarmHost& w = out[static_cast<size_t>(i)];
+        w.host = hosts[i].toStdString();
+
+        // TTLs are only visible through QDnsLookup.
+        auto* dns = new QDnsLookup(QDnsLookup::A, hosts[i], &loop);
+        ++pending;
+        QObject::connect(dns, &QDnsLookup::finished, &loop, [&w, dns, &settle]() {
+            for (const QDnsHostAddressRecord& r : dns->hostAddressRecords()) {
+                const int ttl = static_cast<int>(r.timeToLive());
+                w.ttlSec = w.ttlSec < 0 ? ttl : std::min(w.ttlSec, ttl);
+            }
+            settle();
+        });
+        dns->lookup();
+
+        // This one lands in the cache QNetworkAccessManager reads.
+        ++pending;
+        QHostInfo::lookupHost(hosts[i], &loop, [&w, &clock, &settle](const QHostInfo& info) {
+            w.dnsMs     = clock.elapsed();
+            w.addresses = info.error() == QHostInfo::NoError
+                        ? static_cast<int>(info.addresses().size()) : 0;
+            settle();
+        });
+    }
+    // Callbacks are bound to `loop`, so none can outlive this frame.
+    QTimer::singleShot(LOOKUP_TIMEOUT_MS, &loop, &QEventLoop::quit);
+    if (pending > 0) loop.exec();
+    return out;
+}
+
+void NetWarmup::resolve(const QStringList& hosts) {
+    std::vector<WarmHost> found = lookup(hosts);
+    QMutexLocker lk(&m_lock);
+    m_entries.clear();
+    for (WarmHost& w : found) {
+        Entry e;
+        e.info = std::move(w);
+        e.resolvedAt.start();
+        m_entries.push_back(std::move(e));
+    }
+}
+
+void NetWarmup::refreshExpired() {
+    QStringList due;
+    {
+        QMutexLocker lk(&m_lock);
+        for (const Entry& e : m_entries) {
+            const int ttl = e.info.ttlSec > 0 ? std::min(e.info.ttlSec, QT_CACHE_SEC)
+                                              : QT_CACHE_SEC;
+            if (e.resolvedAt.elapsed() >= ttl * 1000LL) due << QString::fromStdString(e.info.host);
+        }
+    }
+    if (due.isEmpty()) return;
+
+    const std::vector<WarmHost> found = lookup(due);
+    QMutexLocker lk(&m_lock);
+    for (const WarmHost& w : found) {
+        for (Entry& e : m_entries) {
+            if (e.info.host != w.host) continue;
+            // Keep the cold startup figure; only the answer is refreshed.
+            e.info.addresses = w.addresses;
+            if (w.ttlSec >= 0) e.info.ttlSec = w.ttlSec;
+            ++e.info.refreshes;
+            e.resolvedAt.start();
+        }
+    }
+}
+
+void NetWarmup::recordConnect(const QString& host, qint64 ms) {
+    QMutexLocker lk(&m_lock);
+    for (Entry& e : m_entries) {
+        if (e.info.host == host.toStdString() && e.info.connectMs < 0) e.info.connectMs = ms;
+    }
+}
+
+std::vector<WarmHost> NetWarmup::status() const {
+    QMutexLocker lk(&m_lock);
+    std::vector<WarmHost> out;
+    out.reserve(m_entries.size());
+    for (const Entry& e : m_entries) {
+        WarmHost w = e.info;
+        w.ageMs = e.resolvedAt.elapsed();
+        out.push_back(std::move(w));
+    }
+    return out;
+}
+
+QStringList NetWarmup::hosts() const {
+    QMutexLocker lk(&m_lock);
+    QStringList out;
+    for (const Entry& e : m_entries) out << QString::fromStdString(e.info.host);
+    return out;
+}
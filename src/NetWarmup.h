@@ -0,0 +1,65 @@
+#ifndef NETWARMUP_H
+#define NETWARMUP_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <string>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// WarmHost – GET /api/download/warmup
+// ════════════════════════════════════════════════════════════════════════════
+
+struct WarmHost {
+    std::string host;
+    int    addresses = 0;
+    qint64 dnsMs     = -1;   // Cold lookup at startup
+    int    ttlSec    = -1;   // Lowest TTL in the answer; -1 = unknown
+    qint64 connectMs = -1;   // Pre-connect: TCP + TLS + one HEAD round trip
+    qint64 ageMs     = 0;    // Since the last resolve
+    int    refreshes = 0;    // Re-resolves after the TTL ran out
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// NetWarmup – DNS pre-resolution with TTLs for the mirror hosts
+//
+// LauncherCore::init starts this in the background so the first version
+// list or install doesn't pay DNS for each mirror in turn. Every host is
+// looked up in parallel twice: QDnsLookup for the record TTL, and
+// QHostInfo::lookupHost, which fills the resolver cache QNetworkAccess-
+// Manager consults. Qt keeps that cache for at most 60 s whatever the TTL,
+// so refreshExpired() – run on a worker by LauncherCore's warm-up timer,
+// never on the download path – re-resolves hosts whose min(TTL, 60 s) has
+// passed. Pre-connect timings are recorded
+// by LauncherCore::prewarmConnections. Thread-safe; the blocking calls run
+// their own event loop and belong on a worker thread.
+// ════════════════════════════════════════════════════════════════════════════
+
+class NetWarmup {
+public:
+    static constexpr int QT_CACHE_SEC = 60;
+
+    // Blocking. Resolves `hosts` (replacing the set) and records timings.
+    void resolve(const QStringList& hosts);
+    // Blocking but immediate when nothing has expired.
+    void refreshExpired();
+
+    void recordConnect(const QString& host, qint64 ms);
+    std::vector<WarmHost> status() const;
+    QStringList hosts() const;
+
+private:
+    struct Entry {
+        WarmHost      info;
+        QElapsedTimer resolvedAt;
+    };
+    // Runs the lookups for `hosts`; returns per-host (ms, addresses, ttl).
+    static std::vector<WarmHost> lookup(const QStringList& hosts);
+
+    mutable QMutex     m_lock;
+    std::vector<Entry> m_entries;
+};
+
+#endif // NETWARMUP_H
@@ -0,0 +1,111 @@
+// ProgressMeter.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Byte-weighted batch progress with smoothed throughput and ETA.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "ProgressMeter.h"
+#include "BandwidthLimiter.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+
+// Weight of the newest interval in the throughput EWMA; ~1 s memory at 10 Hz.
+static constexpr double RATE_ALPHA = 0.2;
+
+int DownloadProgress::percent() const {
+    if (bytesTotal > 0)
+        return static_cast<int>(std::min<qint64>(100, bytesDone * 100 / bytesTotal));
+    if (filesTotal > 0) return filesDone * 100 / filesTotal;
+    return 100;
+}
+
+ProgressMeter::ProgressMeter(int filesTotal, qint64 bytesTotal, BandwidthLimiter* wire)
+    : m_wire(wire), m_wireStart(wire ? wire->bytesTotal() : 0), m_batchesLeft(0),
+      m_filesTotal(filesTotal), m_bytesTotal(bytesTotal) {
+    m_clock.start();
+    m_lastWire = m_wireStart;
+}
+
+ProgressMeter::ProgressMeter(BandwidthLimiter* wire, int batches)
+    : ProgressMeter(0, 0, wire) {
+    m_batchesLeft = batches;
+}
+
+// Totals first, then the batch count: finished() must never see the last
+// batch accounted for without its files.
+void ProgressMeter::addBatch(int files, qint64 bytes) {
+    m_filesTotal.fetch_add(files);
+    m_bytesTotal.fetch_add(bytes);
+    m_batchesLeft.fetch_sub(1);
+}
+
+bool ProgressMeter::finished() const {
+    return m_batchesLeft.load() <= 0 &&
+           m_filesDone.load(std::memory_order_acquire) >= m_filesTotal.load();
+}
+
+void ProgressMeter::fileDone(qint64 presentBytes, qint64 size) {
+    if (presentBytes > 0) m_presentBytes.fetch_add(presentBytes, std::memory_order_relaxed);
+    else if (size > 0)    m_fetchedBytes.fetch_add(size, std::memory_order_relaxed);
+    m_filesDone.fetch_add(1, std::memory_order_release);
+}
+
+DownloadProgress ProgressMeter::snapshot() {
+    const qint64 nowMs = m_clock.elapsed();
+    const qint64 wire  = m_wire ? m_wire->bytesTotal() : 0;
+
+    // Wire bytes include in-flight bodies (and re-sent ones after a retry);
+    // completed downloads are a floor that also covers resumed prefixes.
+    const qint64 fetched = std::max(m_fetchedBytes.load(std::memory_order_relaxed),
+                                    wire - m_wireStart);
+    const qint64 total   = m_bytesTotal.load();
+    qint64 done = m_presentBytes.load(std::memory_order_relaxed) + fetched;
+    if (total > 0) done = std::min(done, total);
+    m_bytesDone = std::max(m_bytesDone, done);
+
+    const qint64 dt = nowMs - m_lastSampleMs;
+    if (dt > 0) {
+        const double inst = (wire - m_lastWire) * 1000.0 / dt;
+        m_rate = m_lastSampleMs == 0 ? inst : RATE_ALPHA * inst + (1 - RATE_ALPHA) * m_rate;
+        m_lastSampleMs = nowMs;
+        m_lastWire     = wire;
+    }
+
+    DownloadProgress p;
+    p.filesDone   = m_filesDone.load(std::memory_order_acquire);
+    p.filesTotal  = m_filesTotal.load();
+    p.bytesDone   = m_bytesDone;
+    p.bytesTotal  = total;
+    p.bytesPerSec = m_rate;
+    p.finished    = finished();
+    if (p.finished) {
+        p.bytesDone = std::max(p.bytesDone, total);
+        p.etaMs     = 0;
+    } else if (total > 0 && m_rate > 1) {
+        p.etaMs = static_cast<qint64>((total - p.bytesDone) * 1000.0 / m_rate);
+    }
+    return p;
+}
+
+bool ProgressMeter::poll(DownloadProgress& out) {
+    QMutexLocker lk(&m_pollLock);
+    return pollLocked(out);
+}
+
+void ProgressMeter::report(const std::function<void(const DownloadProgress&)>& cb) {
+    if (!cb) return;
+    QMutexLocker lk(&m_pollLock);
+    DownloadProgress p;
+    if (pollLocked(p)) cb(p);
+}
+
+bool ProgressMeter::pollLocked(DownloadProgress& out) {
+    if (m_finalSent) return false;
+    const qint64 nowMs = m_clock.elapsed();
+    if (!finished() && m_lastReportMs >= 0 && nowMs - m_lastReportMs < REPORT_INTERVAL_MS)
+        return false;
+    out = snapshot();
+    m_lastReportMs = nowMs;
+    m_finalSent    = out.finished;
+    return true;
+}
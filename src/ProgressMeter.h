@@ -0,0 +1,93 @@
+#ifndef PROGRESSMETER_H
+#define PROGRESSMETER_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+
+class BandwidthLimiter;
+
+// ════════════════════════════════════════════════════════════════════════════
+// DownloadProgress – one throttled progress report of a batchDownload
+// ════════════════════════════════════════════════════════════════════════════
+
+struct DownloadProgress {
+    int    filesDone   = 0;
+    int    filesTotal  = 0;
+    qint64 bytesDone   = 0;
+    qint64 bytesTotal  = 0;    // Sum of known task sizes
+    double bytesPerSec = 0;    // Smoothed network throughput
+    qint64 etaMs       = -1;   // -1 = unknown
+    bool   finished    = false;
+
+    // Byte-weighted when sizes are known, file-count otherwise. 0..100.
+    int percent() const;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// ProgressMeter – byte-weighted progress for one batch
+//
+// Files already valid on disk count their full size when verified; files
+// being fetched count the body bytes that have passed the BandwidthLimiter
+// since the batch began, so a large jar moves the bar while it streams.
+// Throughput is an EWMA over poll intervals. poll() hands out at most one
+// report per REPORT_INTERVAL_MS (plus the final one), so the number of
+// callbacks – and of signals and WebSocket frames behind them – is bounded
+// by time, not by the number of tasks. Unrelated concurrent batches share
+// the wire counter, so their byte figures overlap; the file counts stay
+// exact.
+//
+// One meter can also span several batches that run side by side (the
+// install pipeline): construct it with the number of batches, and each
+// batchDownload given the meter adds its deduplicated totals via addBatch().
+// It only reports finished once every batch has been added and completed.
+// Thread-safe; any thread may poll().
+// ════════════════════════════════════════════════════════════════════════════
+
+class ProgressMeter {
+public:
+    static constexpr qint64 REPORT_INTERVAL_MS = 100;   // 10 Hz
+
+    ProgressMeter(int filesTotal, qint64 bytesTotal, BandwidthLimiter* wire);
+    // Totals arrive later, one addBatch() per expected batch.
+    ProgressMeter(BandwidthLimiter* wire, int batches);
+
+    void addBatch(int files, qint64 bytes);
+
+    // `presentBytes` = size of a file that was already valid and needed no
+    // transfer; 0 for a file that was downloaded (its bytes came via the wire).
+    void fileDone(qint64 presentBytes, qint64 size);
+
+    // True (and `out` filled) if a report is due; always true once every
+    // file is done, exactly once.
+    bool poll(DownloadProgress& out);
+    // poll(), then `cb` if a report was due – under the meter's lock, so
+    // batches sharing a meter never run the callback concurrently.
+    void report(const std::function<void(const DownloadProgress&)>& cb);
+
+private:
+    bool pollLocked(DownloadProgress& out);   // m_pollLock held
+    DownloadProgress snapshot();              // m_pollLock held
+    bool finished() const;
+
+    BandwidthLimiter*   m_wire;
+    const qint64        m_wireStart;
+    std::atomic<int>    m_batchesLeft;
+    std::atomic<int>    m_filesTotal;
+    std::atomic<qint64> m_bytesTotal;
+    std::atomic<int>    m_filesDone{0};
+    std::atomic<qint64> m_presentBytes{0};
+    std::atomic<qint64> m_fetchedBytes{0};   // Sizes of completed downloads
+    QMutex              m_pollLock;
+    QElapsedTimer       m_clock;
+    qint64              m_lastReportMs = -1;
+    qint64              m_lastSampleMs = 0;
+    qint64              m_lastWire     = 0;
+    qint64              m_bytesDone    = 0;   // Never moves backwards
+    double              m_rate         = 0;
+    bool                m_finalSent    = false;
+};
+
+#endif // PROGRESSMETER_H
@@ -0,0 +1,87 @@
+// RepairQueue.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Persistent list of files to re-verify before the next launch.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "RepairQueue.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <algorithm>
+
+// One line per file: sha1 \t size \t path
+void RepairQueue::load(const QString& file) {
+    QMutexLocker lk(&m_lock);
+    m_file = file;
+    m_entries.clear();
+    m_dirty = false;
+
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) return;
+    while (!f.atEnd()) {
+        const QByteArray line = f.readLine().trimmed();
+        const int a = line.indexOf('\t');
+        const int b = a < 0 ? -1 : line.indexOf('\t', a + 1);
+        if (b < 0) continue;
+        RepairEntry e;
+        e.sha1 = line.left(a).toStdString();
+        e.size = line.mid(a + 1, b - a - 1).toInt();
+        e.path = line.mid(b + 1).toStdString();
+        if (!e.path.empty()) m_entries.push_back(std::move(e));
+    }
+}
+
+bool RepairQueue::save() {
+    QMutexLocker lk(&m_lock);
+    if (!m_dirty || m_file.isEmpty()) return true;
+    if (m_entries.empty()) {
+        QFile::remove(m_file);
+        m_dirty = false;
+        return true;
+    }
+    QDir().mkpath(QFileInfo(m_file).absolutePath());
+    QSaveFile f(m_file);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    for (const RepairEntry& e : m_entries) {
+        f.write(QByteArray::fromStdString(e.sha1) + '\t' + QByteArray::number(e.size) + '\t' +
+                QByteArray::fromStdString(e.path) + '\n');
+    }
+    if (!f.commit()) return false;
+    m_dirty = false;
+    return true;
+}
+
+void RepairQueue::add(const RepairEntry& e) {
+    QMutexLocker lk(&m_lock);
+    for (RepairEntry& have : m_entries) {
+        if (have.path != e.path) continue;
+        have    = e;
+        m_dirty = true;
+        return;
+    }
+    m_entries.push_back(e);
+    m_dirty = true;
+}
+
+void RepairQueue::remove(const std::string& path) {
+    QMutexLocker lk(&m_lock);
+    auto it = std::remove_if(m_entries.begin(), m_entries.end(),
+                             [&](const RepairEntry& e) { return e.path == path; });
+    if (it == m_entries.end()) return;
+    m_entries.erase(it, m_entries.end());
+    m_dirty = true;
+}
+
+bool RepairQueue::contains(const std::string& path) const {
+    QMutexLocker lk(&m_lock);
+    return std::any_of(m_entries.begin(), m_entries.end(),
+                       [&](const RepairEntry& e) { return e.path == path; });
+}
+
+std::vector<RepairEntry> RepairQueue::entries() const {
+    QMutexLocker lk(&m_lock);
+    return m_entries;
+}
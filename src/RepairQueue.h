@@ -0,0 +1,44 @@
+#ifndef REPAIRQUEUE_H
+#define REPAIRQUEUE_H
+
+#include <QMutex>
+#include <QString>
+#include <string>
+#include <vector>
+
+// ════════════════════════════════════════════════════════════════════════════
+// RepairQueue – files a background deep check found missing or corrupt
+//
+// In fast verification mode stepFixFiles trusts files that exist with their
+// manifest size and leaves the SHA-1 pass for after the game has started
+// (LauncherCore::startDeepCheck). That pass can't replace a jar the running
+// game has open, so what fails is recorded here instead – persisted in
+// workDir/cache/repair.list – and the next stepFixFiles sends these files
+// through the full check, which re-downloads them. Entries are dropped once
+// a check passes again. Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+struct RepairEntry {
+    std::string path;
+    int         size = -1;
+    std::string sha1;
+};
+
+class RepairQueue {
+public:
+    void load(const QString& file);
+    bool save();
+
+    void add(const RepairEntry& e);
+    void remove(const std::string& path);
+    bool contains(const std::string& path) const;
+    std::vector<RepairEntry> entries() const;
+
+private:
+    mutable QMutex           m_lock;
+    QString                  m_file;
+    std::vector<RepairEntry> m_entries;
+    bool                     m_dirty = false;
+};
+
+#endif // REPAIRQUEUE_H
@@ -0,0 +1,97 @@
+// RetryPolicy.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Backoff / timeout policy and per-host circuit breakers for downloads.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "RetryPolicy.h"
+
+#include <QMutexLocker>
+#include <QRandomGenerator>
+#include <algorithm>
+
+// ════════════════════════════════════════════════════════════════════════════
+// RetryPolicy
+// ════════════════════════════════════════════════════════════════════════════
+
+int RetryPolicy::backoffMs(int round) const {
+    const qint64 cap = std::min<qint64>(maxDelayMs,
+                                        static_cast<qint64>(baseDelayMs) << std::clamp(round, 0, 20));
+    if (cap <= 0) return 0;
+    return static_cast<int>(QRandomGenerator::global()->bounded(cap + 1));
+}
+
+qint64 RetryPolicy::deadlineMs(qint64 bytes) const {
+    if (bytes <= 0 || floorBps <= 0) return 0;
+    return deadlineSlackMs + bytes * 1000 / floorBps;
+}
+
+// ════════════════════════════════════════════════════════════════════════════
+// CircuitBreakers
+// ════════════════════════════════════════════════════════════════════════════
+
+void CircuitBreakers::configure(int failureThreshold, int cooldownMs, int maxCooldownMs) {
+    QMutexLocker lk(&m_lock);
+    m_threshold     = std::max(1, failureThreshold);
+    m_cooldownMs    = std::max(1000, cooldownMs);
+    m_maxCooldownMs = std::max<qint64>(m_cooldownMs, maxCooldownMs);
+}
+
+// The host answered (even with 404/403) → it is up. Only failures that say
+// something about the host itself count towards opening the breaker.
+bool CircuitBreakers::isHostFailure(const MirrorHealth::Sample& s) {
+    if (s.ok) return false;
+    if (s.httpCode == 429 || s.httpCode >= 500) return true;
+    return s.httpCode == 0 || s.reset || s.stalled;
+}
+
+bool CircuitBreakers::allow(const QString& host) {
+    QMutexLocker lk(&m_lock);
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end()) return true;
+    switch (it->state) {
+        case State::Closed:
+            return true;
+        case State::HalfOpen:
+            return false;   // One probe at a time
+        case State::Open:
+            if (it->openedAt.elapsed() < it->cooldown) return false;
+            it->state = State::HalfOpen;
+            return true;
+    }
+    return true;
+}
+
+void CircuitBreakers::abandon(const QString& host) {
+    QMutexLocker lk(&m_lock);
+    auto it = m_hosts.find(host);
+    // openedAt is already past the cooldown, so the next allow() re-probes.
+    if (it != m_hosts.end() && it->state == State::HalfOpen) it->state = State::Open;
+}
+
+CircuitBreakers::Transition CircuitBreakers::record(const QString& host,
+                                                    const MirrorHealth::Sample& s) {
+    QMutexLocker lk(&m_lock);
+    Breaker& b = m_hosts[host];
+    if (!isHostFailure(s)) {
+        const bool wasTripped = b.state != State::Closed;
+        b.state    = State::Closed;
+        b.failures = 0;
+        b.cooldown = 0;
+        return wasTripped ? Transition::Closed : Transition::None;
+    }
+
+    ++b.failures;
+    if (b.state == State::HalfOpen) {
+        b.state    = State::Open;
+        b.cooldown = std::min(b.cooldown * 2, m_maxCooldownMs);
+        b.openedAt.start();
+        return Transition::Opened;
+    }
+    if (b.state == State::Closed && b.failures >= m_threshold) {
+        b.state    = State::Open;
+        b.cooldown = m_cooldownMs;
+        b.openedAt.start();
+        return Transition::Opened;
+    }
+    return Transition::None;
+}
@@ -0,0 +1,76 @@
+#ifndef RETRYPOLICY_H
+#define RETRYPOLICY_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+#include "MirrorHealth.h"
+
+// ════════════════════════════════════════════════════════════════════════════
+// RetryPolicy – how often, how long and how patiently to retry a transfer
+//
+// A file is tried against every mirror once per round; between rounds the
+// caller sleeps backoffMs(round) (exponential, full jitter) so a brief
+// outage doesn't fail a 4000-file batch and a recovering host isn't hit by
+// every worker at the same instant. Loaded from workDir/download.ini.
+// ════════════════════════════════════════════════════════════════════════════
+
+struct RetryPolicy {
+    int    rounds          = 3;        // Passes over the mirror list
+    int    baseDelayMs     = 500;      // Backoff cap after the first round
+    int    maxDelayMs      = 15000;
+    int    stallTimeoutMs  = 30000;    // No bytes for this long → abort
+    qint64 floorBps        = 32 * 1024;// Slowest acceptable average rate
+    int    deadlineSlackMs = 20000;    // Connect + TTFB allowance on top
+
+    // Random delay in [0, min(maxDelayMs, baseDelayMs · 2^round)].
+    int backoffMs(int round) const;
+    // Whole-transfer deadline for `bytes` (≤ 0 = unknown → no deadline).
+    qint64 deadlineMs(qint64 bytes) const;
+};
+
+// ════════════════════════════════════════════════════════════════════════════
+// CircuitBreakers – per-host closed / open / half-open state
+//
+// `failureThreshold` consecutive host-level failures (transport errors,
+// stalls, 429, 5xx – not a 404 or a bad hash) open the breaker: allow()
+// refuses the host for `cooldown`, after which one probe request is let
+// through. A successful probe closes it; a failed one re-opens it with the
+// cooldown doubled (up to maxCooldownMs). Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class CircuitBreakers {
+public:
+    enum class Transition { None, Opened, Closed };
+
+    // False while the host's breaker is open (or its probe is in flight).
+    bool allow(const QString& host);
+    // Feeds the outcome of a request that allow() let through.
+    Transition record(const QString& host, const MirrorHealth::Sample& s);
+    // allow() was granted but no request was sent (local failure); hands a
+    // half-open probe back so the next caller can take it.
+    void abandon(const QString& host);
+
+    void configure(int failureThreshold, int cooldownMs, int maxCooldownMs);
+
+private:
+    enum class State { Closed, Open, HalfOpen };
+    struct Breaker {
+        State         state     = State::Closed;
+        int           failures  = 0;
+        qint64        cooldown  = 0;
+        QElapsedTimer openedAt;
+    };
+
+    static bool isHostFailure(const MirrorHealth::Sample& s);
+
+    QMutex                  m_lock;
+    QHash<QString, Breaker> m_hosts;
+    int                     m_threshold     = 5;
+    qint64                  m_cooldownMs    = 30000;
+    qint64                  m_maxCooldownMs = 300000;
+};
+
+#endif // RETRYPOLICY_H
@@ -0,0 +1,437 @@
+// Sha1.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  SHA-1 block functions: scalar, x86 SHA-NI, ARMv8 crypto; runtime dispatch.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "Sha1.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QString>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SHA1_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SHA1_TARGET_X86
+#else
+#include <cpuid.h>
+#define SHA1_TARGET_X86 __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+// The ARM kernel is built when the compiler targets the crypto extension
+// (Apple Silicon always does; elsewhere -march=armv8-a+crypto); the CPU is
+// still checked at run time.
+#if (defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))) \
+    || defined(_M_ARM64)
+#define SHA1_ARM 1
+#if defined(_M_ARM64)
+#include <arm64_neon.h>
+#include <windows.h>
+#else
+#include <arm_neon.h>
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+// ── Scalar ───────────────────────────────────────────────────────────────────
+
+static inline uint32_t rol(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+static void blocksScalar(uint32_t state[5], const uint8_t* p, size_t count) {
+    for (; count > 0; --count, p += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i)
+            w[i] = uint32_t(p[4 * i]) << 24 | uint32_t(p[4 * i + 1]) << 16 |
+                   uint32_t(p[4 * i + 2]) << 8 | uint32_t(p[4 * i + 3]);
+        for (int i = 16; i < 80; ++i)
+            w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        // One loop per round function keeps the body branch-free.
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        auto step = [&](uint32_t f, uint32_t k, uint32_t wi) {
+            const uint32_t t = rol(a, 5) + f + e + k + wi;
+            e = d; d = c; c = rol(b, 30); b = a; a = t;
+        };
+        for (int i =  0; i < 20; ++i) step((b & c) | (~b & d),          0x5A827999, w[i]);
+        for (int i = 20; i < 40; ++i) step(b ^ c ^ d,                   0x6ED9EBA1, w[i]);
+        for (int i = 40; i < 60; ++i) step((b & c) | (d & (b | c)),     0x8F1BBCDC, w[i]);
+        for (int i = 60; i < 80; ++i) step(b ^ c ^ d,                   0xCA62C1D6, w[i]);
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d; state[4] += e;
+    }
+}
+
+// ── x86 SHA extensions ───────────────────────────────────────────────────────
+// Four rounds per sha1rnds4. Group g (rounds 4g..4g+3) consumes message
+// word-vector W = M[g%4] and schedules ahead: msg2 finishes M[g+1], msg1
+// starts M[g+3], the xor feeds M[g+2]. Results the last groups compute
+// for rounds past 79 are simply unused.
+
+#if defined(SHA1_X86)
+#define SHA1_NI_GROUP(g, W, Mn, Mx, Mp, Ea, Eb)                     \
+    Ea = _mm_sha1nexte_epu32(Ea, W);                                 \
+    Eb = abcd;                                                       \
+    Mn = _mm_sha1msg2_epu32(Mn, W);                                  \
+    abcd = _mm_sha1rnds4_epu32(abcd, Ea, (g) / 5);                   \
+    Mp = _mm_sha1msg1_epu32(Mp, W);                                  \
+    Mx = _mm_xor_si128(Mx, W);
+
+SHA1_TARGET_X86
+static void blocksShaNi(uint32_t state[5], const uint8_t* p, size_t count) {
+    const __m128i bswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e0   = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; count > 0; --count, p += 64) {
+        const __m128i abcdSave = abcd, e0Save = e0;
+        __m128i e1;
+        __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), bswap);
+        __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), bswap);
+        __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)), bswap);
+        __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)), bswap);
+
+        // Rounds 0-15: the first four groups only start the schedule.
+        e0   = _mm_add_epi32(e0, m0);
+        e1   = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        e1   = _mm_sha1nexte_epu32(e1, m1);
+        e0   = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        m0   = _mm_sha1msg1_epu32(m0, m1);
+
+        e0   = _mm_sha1nexte_epu32(e0, m2);
+        e1   = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        m1   = _mm_sha1msg1_epu32(m1, m2);
+        m0   = _mm_xor_si128(m0, m2);
+
+        SHA1_NI_GROUP( 3, m3, m0, m1, m2, e1, e0)
+        SHA1_NI_GROUP( 4, m0, m1, m2, m3, e0, e1)
+        SHA1_NI_GROUP( 5, m1, m2, m3, m0, e1, e0)
+        SHA1_NI_GROUP( 6, m2, m3, m0, m1, e0, e1)
+        SHA1_NI_GROUP( 7, m3, m0, m1, m2, e1, e0)
+        SHA1_NI_GROUP( 8, m0, m1, m2, m3, e0, e1)
+        SHA1_NI_GROUP( 9, m1, m2, m3, m0, e1, e0)
+        SHA1_NI_GROUP(10, m2, m3, m0, m1, e0, e1)
+        SHA1_NI_GROUP(11, m3, m0, m1, m2, e1, e0)
+        SHA1_NI_GROUP(12, m0, m1, m2, m3, e0, e1)
+        SHA1_NI_GROUP(13, m1, m2, m3, m0, e1, e0)
+        SHA1_NI_GROUP(14, m2, m3, m0, m1, e0, e1)
+        SHA1_NI_GROUP(15, m3, m0, m1, m2, e1, e0)
+        SHA1_NI_GROUP(16, m0, m1, m2, m3, e0, e1)
+        SHA1_NI_GROUP(17, m1, m2, m3, m0, e1, e0)
+        SHA1_NI_GROUP(18, m2, m3, m0, m1, e0, e1)
+        SHA1_NI_GROUP(19, m3, m0, m1, m2, e1, e0)
+
+        e0   = _mm_sha1nexte_epu32(e0, e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+#undef SHA1_NI_GROUP
+
+static bool cpuHasShaNi() {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuid(r, 1);
+    const bool sse = (r[2] & (1 << 9)) && (r[2] & (1 << 19));   // SSSE3, SSE4.1
+    __cpuidex(r, 7, 0);
+    return sse && (r[1] & (1 << 29));
+#else
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return false;
+    const bool sse = (c & bit_SSSE3) && (c & bit_SSE4_1);
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return false;
+    return sse && (b & (1u << 29));
+#endif
+}
+#endif // SHA1_X86
+
+// ── ARMv8 SHA1 instructions ──────────────────────────────────────────────────
+// Same shape as above: group g hashes four rounds with M[g%4] + K, starts
+// M[g+4] (su0) and finishes M[g+3] (su1).
+
+#if defined(SHA1_ARM)
+#if defined(__GNUC__) && !defined(__clang__)
+#define SHA1_TARGET_ARM __attribute__((target("+crypto")))
+#else
+#define SHA1_TARGET_ARM
+#endif
+
+#define SHA1_CE_GROUP(g, f, Ein, Eout, T, Mg, Mg1, Mg2, Mg3, Kn)     \
+    Eout = vsha1h_u32(vgetq_lane_u32(abcd, 0));                      \
+    abcd = f(abcd, Ein, T);                                          \
+    if ((g) <= 17) T = vaddq_u32(Mg2, Kn);                           \
+    if ((g) >= 1 && (g) <= 16) Mg3 = vsha1su1q_u32(Mg3, Mg2);        \
+    if ((g) <= 15) Mg = vsha1su0q_u32(Mg, Mg1, Mg2);
+
+SHA1_TARGET_ARM
+static void blocksArmCrypto(uint32_t state[5], const uint8_t* p, size_t count) {
+    const uint32x4_t k0 = vdupq_n_u32(0x5A827999), k1 = vdupq_n_u32(0x6ED9EBA1),
+                     k2 = vdupq_n_u32(0x8F1BBCDC), k3 = vdupq_n_u32(0xCA62C1D6);
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t   e0   = state[4];
+
+    for (; count > 0; --count, p += 64) {
+        const uint32x4_t abcdSave = abcd;
+        const uint32_t   e0Save   = e0;
+        uint32_t e1;
+        uint32x4_t m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p)));
+        uint32x4_t m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 16)));
+        uint32x4_t m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 32)));
+        uint32x4_t m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 48)));
+        uint32x4_t t0 = vaddq_u32(m0, k0);
+        uint32x4_t t1 = vaddq_u32(m1, k0);
+
+        // K for the vector scheduled two groups ahead: groups 0-2 load k0, ...
+        SHA1_CE_GROUP( 0, vsha1cq_u32, e0, e1, t0, m0, m1, m2, m3, k0)
+        SHA1_CE_GROUP( 1, vsha1cq_u32, e1, e0, t1, m1, m2, m3, m0, k0)
+        SHA1_CE_GROUP( 2, vsha1cq_u32, e0, e1, t0, m2, m3, m0, m1, k0)
+        SHA1_CE_GROUP( 3, vsha1cq_u32, e1, e0, t1, m3, m0, m1, m2, k1)
+        SHA1_CE_GROUP( 4, vsha1cq_u32, e0, e1, t0, m0, m1, m2, m3, k1)
+        SHA1_CE_GROUP( 5, vsha1pq_u32, e1, e0, t1, m1, m2, m3, m0, k1)
+        SHA1_CE_GROUP( 6, vsha1pq_u32, e0, e1, t0, m2, m3, m0, m1, k1)
+        SHA1_CE_GROUP( 7, vsha1pq_u32, e1, e0, t1, m3, m0, m1, m2, k1)
+        SHA1_CE_GROUP( 8, vsha1pq_u32, e0, e1, t0, m0, m1, m2, m3, k2)
+        SHA1_CE_GROUP( 9, vsha1pq_u32, e1, e0, t1, m1, m2, m3, m0, k2)
+        SHA1_CE_GROUP(10, vsha1mq_u32, e0, e1, t0, m2, m3, m0, m1, k2)
+        SHA1_CE_GROUP(11, vsha1mq_u32, e1, e0, t1, m3, m0, m1, m2, k2)
+        SHA1_CE_GROUP(12, vsha1mq_u32, e0, e1, t0, m0, m1, m2, m3, k2)
+        SHA1_CE_GROUP(13, vsha1mq_u32, e1, e0, t1, m1, m2, m3, m0, k3)
+        SHA1_CE_GROUP(14, vsha1mq_u32, e0, e1, t0, m2, m3, m0, m1, k3)
+        SHA1_CE_GROUP(15, vsha1pq_u32, e1, e0, t1, m3, m0, m1, m2, k3)
+        SHA1_CE_GROUP(16, vsha1pq_u32, e0, e1, t0, m0, m1, m2, m3, k3)
+        SHA1_CE_GROUP(17, vsha1pq_u32, e1, e0, t1, m1, m2, m3, m0, k3)
+        SHA1_CE_GROUP(18, vsha1pq_u32, e0, e1, t0, m2, m3, m0, m1, k3)
+        SHA1_CE_GROUP(19, vsha1pq_u32, e1, e0, t1, m3, m0, m1, m2, k3)
+
+        e0   += e0Save;
+        abcd  = vaddq_u32(abcd, abcdSave);
+    }
+    vst1q_u32(state, abcd);
+    state[4] = e0;
+}
+#undef SHA1_CE_GROUP
+
+static bool cpuHasArmCrypto() {
+#if defined(_M_ARM64)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+#elif defined(__linux__) && defined(HWCAP_SHA1)
+    return getauxval(AT_HWCAP) & HWCAP_SHA1;
+#else
+    return true;   // Built for +crypto on a platform without a query (macOS)
+#endif
+}
+#endif // SHA1_ARM
+
+// ── Dispatch ─────────────────────────────────────────────────────────────────
+
+static Sha1::BlockFn blockFn(Sha1::Kernel k) {
+    switch (k) {
+#if defined(SHA1_X86)
+    case Sha1::Kernel::ShaNi:     return blocksShaNi;
+#endif
+#if defined(SHA1_ARM)
+    case Sha1::Kernel::ArmCrypto: return blocksArmCrypto;
+#endif
+    default:                      return blocksScalar;
+    }
+}
+
+std::vector<Sha1::Kernel> Sha1::supported() {
+    std::vector<Kernel> out{ Kernel::Scalar };
+#if defined(SHA1_X86)
+    if (cpuHasShaNi()) out.push_back(Kernel::ShaNi);
+#endif
+#if defined(SHA1_ARM)
+    if (cpuHasArmCrypto()) out.push_back(Kernel::ArmCrypto);
+#endif
+    return out;
+}
+
+Sha1::Kernel Sha1::best() {
+    static const Kernel k = supported().back();
+    return k;
+}
+
+const char* Sha1::name(Kernel k) {
+    switch (k) {
+    case Kernel::ShaNi:     return "sha-ni";
+    case Kernel::ArmCrypto: return "armv8-crypto";
+    default:                return "scalar";
+    }
+}
+
+// ── Streaming ────────────────────────────────────────────────────────────────
+
+Sha1::Sha1(Kernel kernel) : m_blocks(blockFn(kernel)) {
+    reset();
+}
+
+void Sha1::reset() {
+    m_state[0] = 0x67452301;
+    m_state[1] = 0xEFCDAB89;
+    m_state[2] = 0x98BADCFE;
+    m_state[3] = 0x10325476;
+    m_state[4] = 0xC3D2E1F0;
+    m_bufLen = 0;
+    m_total  = 0;
+}
+
+void Sha1::addData(const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    m_total += len;
+    if (m_bufLen > 0) {
+        const size_t take = std::min(len, sizeof(m_buf) - m_bufLen);
+        std::memcpy(m_buf + m_bufLen, p, take);
+        m_bufLen += take;
+        p += take;
+        len -= take;
+        if (m_bufLen < sizeof(m_buf)) return;
+        m_blocks(m_state, m_buf, 1);
+        m_bufLen = 0;
+    }
+    // Whole blocks straight from the caller's buffer.
+    if (len >= 64) {
+        m_blocks(m_state, p, len / 64);
+        p += len & ~size_t(63);
+        len &= 63;
+    }
+    std::memcpy(m_buf, p, len);
+    m_bufLen = len;
+}
+
+std::array<uint8_t, 20> Sha1::result() const {
+    uint32_t state[5];
+    std::memcpy(state, m_state, sizeof(state));
+    uint8_t tail[128] = {};
+    std::memcpy(tail, m_buf, m_bufLen);
+    tail[m_bufLen] = 0x80;
+    const size_t tailLen = m_bufLen < 56 ? 64 : 128;
+    const uint64_t bits = m_total * 8;
+    for (int i = 0; i < 8; ++i) tail[tailLen - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    m_blocks(state, tail, tailLen / 64);
+
+    std::array<uint8_t, 20> out;
+    for (int i = 0; i < 5; ++i) {
+        out[4 * i]     = static_cast<uint8_t>(state[i] >> 24);
+        out[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+        out[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+        out[4 * i + 3] = static_cast<uint8_t>(state[i]);
+    }
+    return out;
+}
+
+std::string Sha1::hex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string s;
+    s.reserve(40);
+    for (uint8_t b : result()) {
+        s += digits[b >> 4];
+        s += digits[b & 15];
+    }
+    return s;
+}
+
+// ── Files ────────────────────────────────────────────────────────────────────
+// A mapping is only taken of files we own (verified or being verified);
+// one truncated underneath us would fault, so nothing else is mapped.
+
+std::string Sha1::fileHex(const QString& path, ReadMode mode) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) return {};
+    const qint64 size = f.size();
+    if (mode == ReadMode::Auto) mode = size >= MAP_MIN_BYTES ? ReadMode::Mapped : ReadMode::Buffered;
+
+    Sha1 h;
+    if (mode == ReadMode::Mapped && size > 0) {
+        if (uchar* p = f.map(0, size)) {
+#if defined(Q_OS_UNIX)
+            ::madvise(p, static_cast<size_t>(size), MADV_SEQUENTIAL);
+#endif
+            h.addData(p, static_cast<size_t>(size));
+            f.unmap(p);
+            return h.hex();
+        }
+        // Not mappable (special file, address space): read it instead.
+    }
+
+#if defined(Q_OS_LINUX)
+    ::posix_fadvise(f.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    // Page-aligned, so the kernel can copy whole pages into it.
+    struct AlignedFree { void operator()(char* p) const { ::operator delete[](p, std::align_val_t(4096)); } };
+    std::unique_ptr<char[], AlignedFree> buf(
+        static_cast<char*>(::operator new[](READ_CHUNK, std::align_val_t(4096))));
+    qint64 n;
+    while ((n = f.read(buf.get(), static_cast<qint64>(READ_CHUNK))) > 0)
+        h.addData(buf.get(), static_cast<size_t>(n));
+    return n < 0 ? std::string() : h.hex();
+}
+
+std::vector<Sha1::FileBenchResult> Sha1::benchmarkFile(const QString& path, int rounds) {
+    std::vector<FileBenchResult> out;
+    const qint64 size = QFile(path).size();
+    if (size <= 0 || rounds < 1) return out;
+    fileHex(path, ReadMode::Buffered);   // Pull it into the page cache first
+
+    auto measure = [&](const char* method, const std::function<void()>& run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) run();
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        out.push_back({ method, secs > 0 ? static_cast<double>(size) * rounds / secs / 1e9 : 0 });
+    };
+    measure("qcryptographichash", [&]() {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly)) return;
+        QCryptographicHash q(QCryptographicHash::Sha1);
+        q.addData(&f);
+        (void)q.result();
+    });
+    measure("buffered", [&]() { fileHex(path, ReadMode::Buffered); });
+    measure("mapped",   [&]() { fileHex(path, ReadMode::Mapped); });
+    return out;
+}
+
+// ── Benchmark ────────────────────────────────────────────────────────────────
+
+std::vector<Sha1::BenchResult> Sha1::benchmark(size_t bytes) {
+    // 1 MiB buffer, reused: measures the kernel, not memory bandwidth.
+    std::vector<uint8_t> buf(size_t(1) << 20);
+    for (size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+
+    std::vector<BenchResult> out;
+    for (Kernel k : supported()) {
+        Sha1 h(k);
+        h.addData(buf.data(), buf.size());   // Warm-up
+        h.reset();
+        const auto start = std::chrono::steady_clock::now();
+        size_t done = 0;
+        for (; done < bytes; done += buf.size()) h.addData(buf.data(), buf.size());
+        volatile uint8_t sink = h.result()[0];
+        (void)sink;
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        out.push_back({ k, secs > 0 ? static_cast<double>(done) / secs / 1e9 : 0 });
+    }
+    return out;
+}
@@ -0,0 +1,84 @@
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class QString;
+
+// ════════════════════════════════════════════════════════════════════════════
+// Sha1 – SHA-1 with runtime dispatch to the CPU's SHA instructions
+//
+// Every library, jar, asset object and Java runtime file is checked against
+// a SHA-1 from its manifest, on download (streamed through DownloadSink)
+// and in validateFile(). QCryptographicHash only has a portable scalar
+// implementation; this picks, once per process, the fastest block function
+// the CPU supports:
+//   ShaNi      x86-64 SHA extensions (Intel Goldmont / Ice Lake+, AMD Zen)
+//   ArmCrypto  ARMv8 SHA1 instructions (Apple Silicon, most ARM64 Linux)
+//   Scalar     portable fallback
+// Only the block function differs, so kernels are interchangeable mid-run.
+// `NetMinecraftLauncher --bench-sha1` prints the throughput of each
+// supported kernel. Not thread-safe per instance; use one per stream.
+//
+// fileHex() hashes a file on disk. Below MAP_MIN_BYTES it reads 1 MiB
+// page-aligned chunks with unbuffered reads and POSIX_FADV_SEQUENTIAL
+// (Linux), so the kernel reads ahead aggressively; larger files (the
+// client jar, the Java `modules` image) are memory-mapped with
+// MADV_SEQUENTIAL and hashed straight from the page cache without a copy.
+// `--bench-hash <file>` compares both against the QCryptographicHash path.
+// ════════════════════════════════════════════════════════════════════════════
+
+class Sha1 {
+public:
+    enum class Kernel { Scalar, ShaNi, ArmCrypto };
+
+    struct BenchResult {
+        Kernel kernel;
+        double gbPerSec;
+    };
+
+    explicit Sha1(Kernel kernel = best());
+
+    void reset();
+    void addData(const void* data, size_t len);
+    // Digest of everything added so far; the instance stays usable.
+    std::array<uint8_t, 20> result() const;
+    std::string hex() const;
+
+    // Fastest kernel this CPU supports, detected on first use.
+    static Kernel best();
+    static std::vector<Kernel> supported();
+    static const char* name(Kernel kernel);
+    // Hashes `bytes` of in-memory data with each supported kernel.
+    static std::vector<BenchResult> benchmark(size_t bytes = size_t(512) << 20);
+
+    enum class ReadMode { Auto, Buffered, Mapped };
+
+    struct FileBenchResult {
+        const char* method;
+        double      gbPerSec;
+    };
+
+    static constexpr int64_t MAP_MIN_BYTES = int64_t(8) << 20;
+    static constexpr size_t  READ_CHUNK    = size_t(1) << 20;
+
+    // Lower-case hex SHA-1 of the file at `path`; empty if it can't be read.
+    static std::string fileHex(const QString& path, ReadMode mode = ReadMode::Auto);
+    // Warm-cache throughput of QCryptographicHash, buffered and mapped reads.
+    static std::vector<FileBenchResult> benchmarkFile(const QString& path, int rounds = 3);
+
+    using BlockFn = void (*)(uint32_t state[5], const uint8_t* blocks, size_t count);
+
+private:
+    BlockFn  m_blocks;
+    uint32_t m_state[5];
+    uint8_t  m_buf[64];
+    size_t   m_bufLen = 0;
+    uint64_t m_total  = 0;
+};
+
+#endif // SHA1_H
@@ -0,0 +1,143 @@
+// VerifiedIndex.cpp
+// ═══════════════════════════════════════════════════════════════════════════
+//  Persistent stat-keyed cache of verified SHA1s.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#include "VerifiedIndex.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+static const QByteArray INDEX_MAGIC = "verified-index 1";
+
+bool VerifiedIndex::stampOf(const std::string& path, Stamp& out) {
+#if defined(Q_OS_WIN)
+    HANDLE h = CreateFileW(QString::fromStdString(path).toStdWString().c_str(),
+                           FILE_READ_ATTRIBUTES,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) return false;
+    BY_HANDLE_FILE_INFORMATION info;
+    const bool ok = GetFileInformationByHandle(h, &info);
+    CloseHandle(h);
+    if (!ok) return false;
+    // FILETIME: 100 ns ticks since 1601.
+    const qint64 ticks = (static_cast<qint64>(info.ftLastWriteTime.dwHighDateTime) << 32)
+                       | info.ftLastWriteTime.dwLowDateTime;
+    out.size    = (static_cast<qint64>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    out.mtimeNs = (ticks - 116444736000000000LL) * 100;
+    out.inode   = (static_cast<quint64>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return false;
+#if defined(Q_OS_MACOS)
+    const timespec& mt = st.st_mtimespec;
+#else
+    const timespec& mt = st.st_mtim;
+#endif
+    out.size    = static_cast<qint64>(st.st_size);
+    out.mtimeNs = static_cast<qint64>(mt.tv_sec) * 1'000'000'000 + mt.tv_nsec;
+    out.inode   = static_cast<quint64>(st.st_ino);
+#endif
+    return true;
+}
+
+void VerifiedIndex::load(const QString& file) {
+    QMutexLocker lk(&m_lock);
+    m_file = file;
+    m_entries.clear();
+    m_dirty = false;
+
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) return;
+    const QList<QByteArray> head = f.readLine().trimmed().split(' ');
+    if (head.size() != 3 || head[0] + ' ' + head[1] != INDEX_MAGIC) return;
+    const qint64 savedNs = head[2].toLongLong();
+
+    while (!f.atEnd()) {
+        const QByteArray line = f.readLine();
+        // sha1 \t size \t mtime \t inode \t path – the path goes last and
+        // may itself contain tabs.
+        int at[4];
+        int from = 0;
+        bool ok = true;
+        for (int& a : at) {
+            a = line.indexOf('\t', from);
+            if (a < 0) { ok = false; break; }
+            from = a + 1;
+        }
+        if (!ok) continue;
+        Entry e;
+        e.sha1          = line.left(at[0]).toStdString();
+        e.stamp.size    = line.mid(at[0] + 1, at[1] - at[0] - 1).toLongLong();
+        e.stamp.mtimeNs = line.mid(at[1] + 1, at[2] - at[1] - 1).toLongLong();
+        e.stamp.inode   = line.mid(at[2] + 1, at[3] - at[2] - 1).toULongLong();
+        // Written in the same tick as the save: a later write may not have
+        // moved the mtime, so this one has to be hashed again.
+        if (e.stamp.mtimeNs >= savedNs - RACY_WINDOW_NS) { m_dirty = true; continue; }
+        std::string path = line.mid(at[3] + 1).chopped(line.endsWith('\n') ? 1 : 0).toStdString();
+        m_entries.emplace(std::move(path), std::move(e));
+    }
+}
+
+bool VerifiedIndex::save() {
+    QMutexLocker lk(&m_lock);
+    if (!m_dirty || m_file.isEmpty()) return true;
+    QDir().mkpath(QFileInfo(m_file).absolutePath());
+
+    QSaveFile f(m_file);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    const qint64 nowNs = QDateTime::currentMSecsSinceEpoch() * 1'000'000;
+    f.write(INDEX_MAGIC + ' ' + QByteArray::number(nowNs) + '\n');
+    for (const auto& [path, e] : m_entries) {
+        QByteArray line;
+        line.reserve(static_cast<qsizetype>(path.size()) + 80);
+        line += QByteArray::fromStdString(e.sha1);
+        line += '\t' + QByteArray::number(e.stamp.size);
+        line += '\t' + QByteArray::number(e.stamp.mtimeNs);
+        line += '\t' + QByteArray::number(e.stamp.inode);
+        line += '\t' + QByteArray::fromStdString(path) + '\n';
+        f.write(line);
+    }
+    if (!f.commit()) return false;
+    m_dirty = false;
+    return true;
+}
+
+bool VerifiedIndex::lookup(const std::string& path, qint64 size, const std::string& sha1) const {
+    Stamp now;
+    const bool exists = stampOf(path, now);
+    QMutexLocker lk(&m_lock);
+    auto it = m_entries.find(path);
+    const bool hit = exists && it != m_entries.end() && it->second.sha1 == sha1 &&
+                     it->second.stamp == now && (size <= 0 || now.size == size);
+    ++(hit ? m_hits : m_misses);
+    return hit;
+}
+
+void VerifiedIndex::record(const std::string& path, const std::string& sha1) {
+    if (sha1.empty()) return;
+    Stamp now;
+    if (!stampOf(path, now)) return;
+    QMutexLocker lk(&m_lock);
+    Entry& e = m_entries[path];
+    if (e.sha1 == sha1 && e.stamp == now) return;
+    e.sha1  = sha1;
+    e.stamp = now;
+    m_dirty = true;
+}
+
+void VerifiedIndex::forget(const std::string& path) {
+    QMutexLocker lk(&m_lock);
+    if (m_entries.erase(path)) m_dirty = true;
+}
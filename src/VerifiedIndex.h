@@ -0,0 +1,70 @@
+#ifndef VERIFIEDINDEX_H
+#define VERIFIEDINDEX_H
+
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+#include <string>
+#include <unordered_map>
+
+// ════════════════════════════════════════════════════════════════════════════
+// VerifiedIndex – (path, size, mtime, inode) → SHA1 that was verified
+//
+// validateFile() used to hash every library, jar and asset object on every
+// launch. A file whose size, modification time and inode (file index on
+// Windows) are unchanged since it was last hashed or written from a
+// verified body still has that content, so a warm launch only needs a stat
+// per file. Anything that rewrites a file – our own downloads, a user
+// replacing a jar, a restore from backup – changes at least one of them.
+//
+// The index lives in workDir/cache/verified.idx, one line per file, and is
+// saved after DiskSync::flush() so it never vouches for data that is not
+// durable yet. Like git's index it guards against the mtime tick: entries
+// whose mtime is within RACY_WINDOW_NS of the save time are dropped on load,
+// since the file could have changed again within the same tick.
+// Thread-safe.
+// ════════════════════════════════════════════════════════════════════════════
+
+class VerifiedIndex {
+public:
+    // FAT keeps mtimes to 2 s; finer filesystems are covered by the same bound.
+    static constexpr qint64 RACY_WINDOW_NS = 2'000'000'000;
+
+    void load(const QString& file);
+    // Writes the index if anything changed since the last load/save.
+    bool save();
+
+    // True if `path` is recorded with `sha1` and its metadata still matches.
+    // `size` > 0 is checked against the file as well.
+    bool lookup(const std::string& path, qint64 size, const std::string& sha1) const;
+    // `path` now holds content with `sha1` (just hashed or just committed).
+    void record(const std::string& path, const std::string& sha1);
+    void forget(const std::string& path);
+
+    qint64 hits()   const { return m_hits; }
+    qint64 misses() const { return m_misses; }
+
+private:
+    struct Stamp {
+        qint64  size    = -1;
+        qint64  mtimeNs = 0;
+        quint64 inode   = 0;
+        bool operator==(const Stamp& o) const {
+            return size == o.size && mtimeNs == o.mtimeNs && inode == o.inode;
+        }
+    };
+    struct Entry {
+        Stamp       stamp;
+        std::string sha1;
+    };
+    static bool stampOf(const std::string& path, Stamp& out);
+
+    mutable QMutex                         m_lock;
+    QString                                m_file;
+    std::unordered_map<std::string, Entry> m_entries;
+    bool                                   m_dirty  = false;
+    mutable qint64                         m_hits   = 0;
+    mutable qint64                         m_misses = 0;
+};
+
+#endif // VERIFIEDINDEX_H
@@ -3,10 +3,30 @@
 #include <QUrl>
 #include <QDir>
 #include <iostream>
+#include <cstring>
 #include "LauncherCore.h"
+#include "Sha1.h"
 #include "HttpServer.h"
 
 int main(int argc, char *argv[]) {
+    // --bench-sha1: report each supported SHA-1 kernel's throughput and exit.
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-sha1") != 0) continue;
+        std::cout << "SHA-1 kernels (active: " << Sha1::name(Sha1::best()) << ")" << std::endl;
+        for (const Sha1::BenchResult& r : Sha1::benchmark())
+            std::cout << "  " << Sha1::name(r.kernel) << ": " << r.gbPerSec << " GB/s" << std::endl;
+        return 0;
+    }
+    // --bench-hash <file>: file hashing throughput per read method, warm cache.
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-hash") != 0) continue;
+        const QString file = QString::fromLocal8Bit(argv[i + 1]);
+        std::cout << "SHA-1 of " << argv[i + 1] << " (" << Sha1::name(Sha1::best()) << ")" << std::endl;
+        for (const Sha1::FileBenchResult& r : Sha1::benchmarkFile(file))
+            std::cout << "  " << r.method << ": " << r.gbPerSec << " GB/s" << std::endl;
+        return 0;
+    }
+
     QCoreApplication app(argc, argv);
 
     std::cout << "Starting Net Minecraft Launcher Server..." << std::endl;